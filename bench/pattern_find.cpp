@@ -0,0 +1,79 @@
+// times byte_pattern::find at every simd level the host supports on random data, for patterns of a few lengths with
+// and without a wildcard. level::scalar is the horspool skip, the others the pair prefilter
+
+#include <core/scanner/pattern.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <print>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+    using clock = std::chrono::steady_clock;
+    using core::simd::level;
+
+    constexpr std::size_t buffer_size = 64 * 1024 * 1024;
+    constexpr int repeats = 3;
+    constexpr std::array lengths = {4uz, 10uz, 16uz, 32uz, 64uz, 128uz};
+    constexpr std::array levels = {level::scalar, level::sse2, level::avx2, level::avx512};
+    constexpr std::array level_names = {"scalar", "sse2", "avx2", "avx512"};
+
+    // random bytes, a ?? in the middle when wildcard is set
+    std::string pattern_text(std::size_t length, bool wildcard, std::mt19937_64& rng) {
+        std::string text;
+        for (std::size_t i = 0; i < length; ++i) {
+            text += wildcard && i == length / 2 ? std::string("??") : std::format("{:02X}", rng() & 0xFF);
+            text += ' ';
+        }
+        return text;
+    }
+
+    // gigabytes per second at the best of a few passes
+    double time_find(const core::byte_pattern& pattern, std::span<const std::byte> data, std::uint32_t* out, level l) {
+        double best = 0;
+        for (int r = 0; r < repeats; ++r) {
+            const auto start = clock::now();
+            const std::size_t found = pattern.find(data, out, l);
+            const double seconds = std::chrono::duration<double>(clock::now() - start).count();
+            // random data matches a few bytes at most, keep the count alive so the call isn't dropped
+            if (found > data.size())
+                return 0;
+            best = std::max(best, static_cast<double>(data.size()) / seconds / 1e9);
+        }
+        return best;
+    }
+} // namespace
+
+int main() {
+    std::mt19937_64 rng(1);
+    std::vector<std::byte> data(buffer_size);
+    std::ranges::generate(data, [&] {
+        return static_cast<std::byte>(rng());
+    });
+    std::vector<std::uint32_t> out(data.size() + 1);
+
+    const level host = core::simd::supported_level();
+    std::print("{:>8} {:>8}", "length", "wildcard");
+    for (std::size_t i = 0; i < levels.size() && levels[i] <= host; ++i) {
+        std::print(" {:>8}", level_names[i]);
+    }
+    std::println("   GB/s");
+
+    for (const std::size_t length : lengths) {
+        for (const bool wildcard : {false, true}) {
+            const auto pattern = core::byte_pattern::parse(pattern_text(length, wildcard, rng));
+            std::print("{:>8} {:>8}", length, wildcard ? "yes" : "no");
+            for (std::size_t i = 0; i < levels.size() && levels[i] <= host; ++i) {
+                std::print(" {:>8.2f}", time_find(*pattern, data, out.data(), levels[i]));
+            }
+            std::println();
+        }
+    }
+}
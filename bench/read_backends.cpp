@@ -0,0 +1,151 @@
+// times pread on /proc/[pid]/mem against process_vm_readv for reads of one size after another from a child
+// process, which is what linux_controller's pread_limit is picked from. run it as a user that may ptrace its own
+// children
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <print>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    constexpr std::size_t buffer_size = 64 * 1024 * 1024;
+    constexpr std::size_t page_size = 0x1000;
+    constexpr int repeats = 5;
+
+    // bytes read per pass, so every size moves about the same amount and small ones still run long enough to time
+    constexpr std::size_t bytes_per_pass = 64 * 1024 * 1024;
+
+    // a child that holds the same touched buffer at the same address until told to exit
+    struct child {
+        pid_t pid = -1;
+        int release = -1;
+
+        ~child() {
+            if (release != -1) {
+                close(release);
+            }
+            if (pid > 0) {
+                waitpid(pid, nullptr, 0);
+            }
+        }
+    };
+
+    // microseconds per read at the best of a few passes, reads spread over the buffer a few pages apart
+    template<typename Read>
+    double time_reads(std::byte* buffer, std::size_t size, Read read) {
+        const std::size_t count = std::clamp<std::size_t>(bytes_per_pass / size, 64, 200000);
+        const std::size_t span = buffer_size - size;
+
+        double best = 0;
+        for (int r = 0; r < repeats; ++r) {
+            const auto start = clock::now();
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::size_t offset = i * 7 * page_size % span;
+                if (read(buffer + offset, size) != static_cast<ssize_t>(size)) {
+                    return -1;
+                }
+            }
+            const double us = std::chrono::duration<double, std::micro>(clock::now() - start).count() /
+                              static_cast<double>(count);
+            best = r == 0 ? us : std::min(best, us);
+        }
+        return best;
+    }
+} // namespace
+
+int main() {
+    auto* buffer = static_cast<std::byte*>(
+            mmap(nullptr, buffer_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+    );
+    if (buffer == MAP_FAILED) {
+        std::println(stderr, "mmap failed: {}", std::strerror(errno));
+        return 1;
+    }
+    std::memset(buffer, 0x5a, buffer_size);
+
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0) {
+        std::println(stderr, "pipe failed: {}", std::strerror(errno));
+        return 1;
+    }
+
+    child c;
+    c.pid = fork();
+    if (c.pid == 0) {
+        close(pipe_fds[1]);
+        char byte;
+        while (read(pipe_fds[0], &byte, 1) < 0 && errno == EINTR) {
+        }
+        _exit(0);
+    }
+    close(pipe_fds[0]);
+    c.release = pipe_fds[1];
+    if (c.pid < 0) {
+        std::println(stderr, "fork failed: {}", std::strerror(errno));
+        return 1;
+    }
+
+    const int mem_fd = open(std::format("/proc/{}/mem", c.pid).c_str(), O_RDONLY | O_CLOEXEC);
+    if (mem_fd == -1) {
+        std::println(stderr, "opening /proc/{}/mem failed: {}", c.pid, std::strerror(errno));
+        return 1;
+    }
+
+    std::vector<std::byte> out(buffer_size);
+    auto vm_read = [&](std::byte* address, std::size_t size) {
+        iovec local{out.data(), size};
+        iovec remote{address, size};
+        return process_vm_readv(c.pid, &local, 1, &remote, 1, 0);
+    };
+    auto pread_mem = [&](std::byte* address, std::size_t size) {
+        return pread(mem_fd, out.data(), size, static_cast<off_t>(reinterpret_cast<std::uintptr_t>(address)));
+    };
+
+    std::println("{:>10} {:>14} {:>14} {:>8}", "bytes", "pread us", "vm_readv us", "ratio");
+
+    // the smallest size from which process_vm_readv stays ahead, single rows below it are noise either way
+    std::optional<std::size_t> crossover;
+    for (std::size_t size = 64; size <= 8 * 1024 * 1024; size *= 2) {
+        for (const std::size_t s : {size, size + size / 2}) {
+            if (s > 8 * 1024 * 1024)
+                continue;
+
+            const double file = time_reads(buffer, s, pread_mem);
+            const double vm = time_reads(buffer, s, vm_read);
+            if (file < 0 || vm < 0) {
+                std::println(stderr, "a {} byte read came back short", s);
+                close(mem_fd);
+                return 1;
+            }
+
+            std::println("{:>10} {:>14.3f} {:>14.3f} {:>8.2f}", s, file, vm, file / vm);
+            if (vm >= file) {
+                crossover.reset();
+            } else if (!crossover) {
+                crossover = s;
+            }
+        }
+    }
+    close(mem_fd);
+
+    if (crossover) {
+        std::println("process_vm_readv stays faster from {} bytes", *crossover);
+    } else {
+        std::println("pread was faster at the largest size");
+    }
+    return 0;
+}
@@ -16,6 +16,7 @@
 #include "ui/views/disassembly.h"
 #include "ui/views/file_info.h"
 #include "ui/views/memory.h"
+#include "ui/views/multi_scanner.h"
 #include "ui/views/processes.h"
 #include "ui/views/scanner.h"
 #include "ui/views/strings.h"
@@ -73,6 +74,7 @@ namespace app {
         m_views.push_back({std::make_unique<ui::file_info_view>(), false});
         m_views.push_back({std::make_unique<ui::memory_view>(), false});
         m_views.push_back({std::make_unique<ui::scanner_view>(), false});
+        m_views.push_back({std::make_unique<ui::multi_scanner_view>(), false});
         m_views.push_back({std::make_unique<ui::strings_view>(), false});
         m_views.push_back({std::make_unique<ui::diff_view>(), false});
         m_views.push_back({std::make_unique<ui::xref_view>(), false});
@@ -131,7 +133,9 @@ namespace app {
             if (ImGui::Button("Open")) {
                 auto file_target = core::file_target::create(path_buf);
                 if (file_target) {
+                    freezer->set_target(nullptr);
                     active_target = std::make_unique<core::file_target>(std::move(*file_target));
+                    page_cache->set_target(active_target.get());
                 }
                 m_show_open_file_popup = false;
                 ImGui::CloseCurrentPopup();
@@ -174,6 +178,8 @@ namespace app {
                     m_show_open_file_popup = true;
                 }
                 if (ImGui::MenuItem("Close Target", nullptr, false, active_target != nullptr)) {
+                    freezer->set_target(nullptr);
+                    page_cache->set_target(nullptr);
                     active_target.reset();
                 }
                 ImGui::Separator();
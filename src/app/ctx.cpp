@@ -4,4 +4,6 @@
 namespace app {
     std::unique_ptr<core::target> active_target = nullptr;
     std::unique_ptr<core::analysis::strings_analyzer> strings = std::make_unique<core::analysis::strings_analyzer>();
+    std::unique_ptr<core::freezer> freezer = std::make_unique<core::freezer>(nullptr);
+    std::unique_ptr<core::caching_target> page_cache = std::make_unique<core::caching_target>(nullptr);
 } // namespace app
@@ -1,10 +1,19 @@
 #pragma once
 
 #include <core/analysis/strings.h>
+#include <core/caching_target.h>
+#include <core/freezer.h>
 #include <core/target.h>
 #include <memory>
 
 namespace app {
     extern std::unique_ptr<core::target> active_target;
     extern std::unique_ptr<core::analysis::strings_analyzer> strings;
+    // outlives views so frozen values keep being held while the scanner is closed. whatever replaces or detaches
+    // active_target hands the freezer the new one first, its thread must not touch a target that's gone
+    extern std::unique_ptr<core::freezer> freezer;
+    // active_target behind a page cache for the views, which read the same pages every frame. scans and the freezer
+    // go to active_target itself. whatever replaces active_target or attaches it elsewhere points the cache at it
+    // afterwards
+    extern std::unique_ptr<core::caching_target> page_cache;
 }; // namespace app
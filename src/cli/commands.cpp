@@ -48,6 +48,7 @@ namespace cli {
             auto file_target = core::file_target::create(args[0]);
             if (file_target) {
                 app::active_target = std::make_unique<core::file_target>(std::move(*file_target));
+                app::page_cache->set_target(app::active_target.get());
                 std::println("Successfully opened file '{}'.", args[0]);
             } else {
                 std::println(stderr, "Failed to open or parse file '{}'.", args[0]);
@@ -4,6 +4,7 @@
 #include <cctype>
 #include <cstring>
 #include <ranges>
+#include <util/affinity.h>
 
 namespace core::analysis {
 
@@ -15,7 +16,11 @@ namespace core::analysis {
 
     void strings_analyzer::scan(target* t, string_scan_config config) {
         cancel();
-        clear();
+        {
+            std::unique_lock lock(results_mutex);
+            previous = std::move(results);
+            results = {};
+        }
 
         scanning = true;
         cancel_req = false;
@@ -36,15 +41,25 @@ namespace core::analysis {
     }
 
     void strings_analyzer::clear() {
+        cancel();
         std::unique_lock lock(results_mutex);
         results.clear();
         results.shrink_to_fit();
+        previous.clear();
+        previous.shrink_to_fit();
+        last_target = nullptr;
+        last_regions.clear();
+        last_generation.reset();
     }
 
     bool strings_analyzer::is_scanning() const {
         return scanning;
     }
 
+    std::size_t strings_analyzer::skipped_bytes() const {
+        return bytes_skipped;
+    }
+
     float strings_analyzer::progress() const {
         return progress_val;
     }
@@ -85,23 +100,40 @@ namespace core::analysis {
     }
 
     std::string strings_analyzer::read_string(target* t, const string_ref& ref) const {
+        std::vector<std::string> out;
+        read_strings(t, std::span(&ref, 1), out);
+        return std::move(out.front());
+    }
+
+    void
+    strings_analyzer::read_strings(target* t, std::span<const string_ref> refs, std::vector<std::string>& out) const {
+        out.assign(refs.size(), {});
         if (!t)
-            return {};
+            return;
 
         constexpr std::size_t max_display_len = 256;
-        std::size_t len = std::min<std::size_t>(ref.length, max_display_len);
 
-        std::string s;
-        s.resize(len);
+        // the requests point into out, it isn't resized until they are done
+        std::vector<read_request> requests;
+        requests.reserve(refs.size());
+        for (std::size_t i = 0; i < refs.size(); ++i) {
+            out[i].resize(std::min<std::size_t>(refs[i].length, max_display_len));
+            requests.push_back({refs[i].address, std::as_writable_bytes(std::span(out[i]))});
+        }
+
+        std::vector<std::uint8_t> readable(refs.size());
+        t->read_memory_batch(requests, readable);
 
-        if (t->read_memory(ref.address, std::as_writable_bytes(std::span(s)))) {
-            for (char& c : s) {
+        for (std::size_t i = 0; i < refs.size(); ++i) {
+            if (!readable[i]) {
+                out[i] = "??";
+                continue;
+            }
+            for (char& c : out[i]) {
                 if (static_cast<unsigned char>(c) < 0x20 && c != '\t')
                     c = '.';
             }
-            return s;
         }
-        return "??";
     }
 
     void strings_analyzer::worker(target* t, string_scan_config config) {
@@ -110,25 +142,31 @@ namespace core::analysis {
             return;
         }
 
-        auto regions_exp = t->get_memory_regions();
-        if (!regions_exp) {
+        auto table = t->get_region_table();
+        if (!table) {
             scanning = false;
             return;
         }
 
-        auto regions = *regions_exp;
+        pin_current_thread(t->budget().cpus());
 
-        std::erase_if(regions, [&](const auto& r) {
-            bool is_exec = r.permission.find('x') != std::string::npos;
-            if (is_exec && !config.scan_executable)
-                return true;
-            bool is_readable = r.permission.find('r') != std::string::npos;
-            return !is_readable;
-        });
+        std::vector<memory_region> regions;
+        for (const auto& e : (*table)->entries()) {
+            if (e.has(perm::read) && (config.scan_executable || !e.has(perm::exec))) {
+                regions.push_back((*table)->region(e));
+            }
+        }
 
         std::size_t total_bytes = 0;
-        for (const auto& r : regions)
+        for (const auto& r : regions) {
             total_bytes += r.size;
+            t->advise(r.base_address, r.size, access_pattern::sequential);
+        }
+
+        // only this thread touches the previous scan while it runs
+        const auto since = t == last_target && config == last_config ? last_generation : std::nullopt;
+        const auto generation = t->sync_dirty();
+        std::ranges::sort(regions);
 
         std::size_t bytes_processed = 0;
 
@@ -137,6 +175,8 @@ namespace core::analysis {
 
         const std::size_t chunk_size = 64 * 1024;
         std::vector<std::byte> buffer(chunk_size);
+        std::vector<memory_run> runs;
+        bytes_skipped = 0;
 
         for (const auto& r : regions) {
             if (cancel_req)
@@ -145,41 +185,69 @@ namespace core::analysis {
             std::uintptr_t current = r.base_address;
             std::size_t remaining = r.size;
 
+            // strings end at chunk borders, so a chunk only matches the last scan when its region does
+            const bool known = since && std::ranges::binary_search(last_regions, r);
+
             while (remaining > 0 && !cancel_req) {
                 std::size_t read_size = std::min(remaining, chunk_size);
                 std::span<std::byte> view(buffer.data(), read_size);
 
-                if (t->read_memory(current, view)) {
-                    std::size_t str_start = 0;
-                    bool in_string = false;
+                if (known && !t->written_since(current, read_size, *since)) {
+                    auto first = std::ranges::lower_bound(previous, current, {}, &string_ref::address);
+                    auto last = std::ranges::lower_bound(first, previous.end(), current + read_size, {},
+                                                         &string_ref::address);
+                    local_results.insert(local_results.end(), first, last);
+                } else {
+                    // with resident_only just the runs of pages already in memory, each searched on its own. zero
+                    // filled runs hold no strings and aren't read either way
+                    if (config.resident_only) {
+                        bytes_skipped += resident_runs(*t, current, read_size, runs);
+                    } else {
+                        t->data_runs(current, read_size, runs);
+                    }
 
-                    const std::byte* ptr = view.data();
-                    const std::byte* end = ptr + read_size;
+                    for (const auto& run : runs) {
+                        // targets that hold their bytes lend them, nothing is copied or charged for those
+                        const auto into = view.subspan(run.address - current, run.size);
+                        std::span<const std::byte> piece = into;
+                        if (auto lent = t->view_memory(run.address, run.size)) {
+                            piece = *lent;
+                        } else if (!t->budget().acquire(run.size, 1, cancel_req) ||
+                                   !t->read_memory(run.address, into)) {
+                            continue;
+                        }
 
-                    for (const std::byte* p = ptr; p < end; ++p) {
-                        unsigned char c = static_cast<unsigned char>(*p);
-                        bool is_printable = (c >= 0x20 && c <= 0x7E) || c == '\t';
+                        std::size_t str_start = 0;
+                        bool in_string = false;
 
-                        if (in_string) {
-                            if (!is_printable) {
-                                std::size_t len = static_cast<std::size_t>(p - ptr) - str_start;
-                                if (len >= config.min_length) {
-                                    local_results.push_back({current + str_start, static_cast<uint32_t>(len)});
+                        const std::byte* ptr = piece.data();
+                        const std::byte* end = ptr + run.size;
+
+                        for (const std::byte* p = ptr; p < end; ++p) {
+                            unsigned char c = static_cast<unsigned char>(*p);
+                            bool is_printable = (c >= 0x20 && c <= 0x7E) || c == '\t';
+
+                            if (in_string) {
+                                if (!is_printable) {
+                                    std::size_t len = static_cast<std::size_t>(p - ptr) - str_start;
+                                    if (len >= config.min_length) {
+                                        local_results.push_back({run.address + str_start, static_cast<uint32_t>(len)});
+                                    }
+                                    in_string = false;
+                                }
+                            } else {
+                                if (is_printable) {
+                                    in_string = true;
+                                    str_start = static_cast<std::size_t>(p - ptr);
                                 }
-                                in_string = false;
-                            }
-                        } else {
-                            if (is_printable) {
-                                in_string = true;
-                                str_start = static_cast<std::size_t>(p - ptr);
                             }
                         }
-                    }
 
-                    if (in_string) {
-                        std::size_t len = read_size - str_start;
-                        if (len >= config.min_length) {
-                            local_results.push_back({current + str_start, static_cast<uint32_t>(len)});
+                        if (in_string) {
+                            std::size_t len = run.size - str_start;
+                            if (len >= config.min_length) {
+                                local_results.push_back({run.address + str_start, static_cast<uint32_t>(len)});
+                            }
                         }
                     }
                 }
@@ -206,7 +274,16 @@ namespace core::analysis {
 
             std::unique_lock lock(results_mutex);
             results = std::move(local_results);
+            last_target = t;
+            last_config = config;
+            last_regions = std::move(regions);
+            last_generation = generation;
+        } else {
+            std::unique_lock lock(results_mutex);
+            last_target = nullptr;
+            last_generation.reset();
         }
+        previous.clear();
 
         scanning = false;
         progress_val = 1.0f;
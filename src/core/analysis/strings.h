@@ -23,6 +23,9 @@ namespace core::analysis {
     struct string_scan_config {
         std::size_t min_length = 4;
         bool scan_executable = false;
+        bool resident_only = false; // leave out pages that reading would fault in
+
+        bool operator==(const string_scan_config&) const = default;
     };
 
     class strings_analyzer {
@@ -40,12 +43,16 @@ namespace core::analysis {
         [[nodiscard]] bool is_scanning() const;
         [[nodiscard]] float progress() const;
         [[nodiscard]] std::size_t count() const;
+        // bytes the last scan left out with resident_only
+        [[nodiscard]] std::size_t skipped_bytes() const;
 
         std::size_t get_batch(std::size_t start_index, std::span<string_ref> out_buffer) const;
 
         [[nodiscard]] std::optional<string_ref> find_exact(std::uintptr_t address) const;
 
         [[nodiscard]] std::string read_string(target* t, const string_ref& ref) const;
+        // read_string for many at once, in one batch. out gets one string per ref
+        void read_strings(target* t, std::span<const string_ref> refs, std::vector<std::string>& out) const;
 
     private:
         void worker(target* t, string_scan_config config);
@@ -53,10 +60,19 @@ namespace core::analysis {
         mutable std::shared_mutex results_mutex;
         std::vector<string_ref> results;
 
+        // what the last finished scan covered. a rescan of the same target with the same settings takes the strings
+        // of chunks nothing wrote to since from there instead of reading them again
+        std::vector<string_ref> previous;
+        target* last_target = nullptr;
+        string_scan_config last_config;
+        std::vector<memory_region> last_regions;
+        std::optional<std::uint32_t> last_generation;
+
         std::jthread scan_thread;
         std::atomic<bool> scanning = false;
         std::atomic<bool> cancel_req = false;
         std::atomic<float> progress_val = 0.0f;
+        std::atomic<std::size_t> bytes_skipped = 0;
     };
 
 } // namespace core::analysis
@@ -0,0 +1,331 @@
+#include <core/caching_target.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace core {
+    namespace {
+        struct pending_piece {
+            std::size_t request;
+            std::size_t offset;      // into the request's buffer
+            std::size_t miss;        // index into the pages read this call
+            std::size_t page_offset; // into that page
+            std::size_t size;
+        };
+    } // namespace
+
+    caching_target::caching_target(target* inner, std::size_t byte_budget, std::chrono::milliseconds max_age)
+        : m_inner(inner), m_pages_per_shard(std::max<std::size_t>(1, byte_budget / page_size / shard_count)),
+          m_max_age_ms(max_age.count()) {
+    }
+
+    void caching_target::set_target(target* inner) {
+        m_inner = inner;
+        for (auto& s : m_shards) {
+            std::lock_guard lock(s.mutex);
+            s.lru.clear();
+            s.index.clear();
+        }
+        invalidate();
+    }
+
+    void caching_target::invalidate() {
+        m_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void caching_target::set_max_age(std::chrono::milliseconds max_age) {
+        m_max_age_ms = max_age.count();
+    }
+
+    page_cache_stats caching_target::stats() const {
+        page_cache_stats out{m_hits.load(std::memory_order_relaxed), m_misses.load(std::memory_order_relaxed), 0};
+        for (auto& s : m_shards) {
+            std::lock_guard lock(s.mutex);
+            out.pages += s.lru.size();
+        }
+        return out;
+    }
+
+    caching_target::shard& caching_target::shard_of(std::uintptr_t page_address) {
+        return m_shards[(page_address / page_size) % shard_count];
+    }
+
+    bool caching_target::lookup(
+            std::uintptr_t page_address, std::span<std::byte> out, std::size_t offset, bool& readable
+    ) {
+        auto& s = shard_of(page_address);
+        std::lock_guard lock(s.mutex);
+
+        auto it = s.index.find(page_address);
+        if (it == s.index.end())
+            return false;
+
+        const auto& p = *it->second;
+        const auto max_age = std::chrono::milliseconds(m_max_age_ms.load(std::memory_order_relaxed));
+        if (p.generation != m_generation.load(std::memory_order_relaxed) || clock::now() - p.read_at >= max_age) {
+            s.lru.erase(it->second);
+            s.index.erase(it);
+            return false;
+        }
+
+        readable = p.readable;
+        if (readable) {
+            std::memcpy(out.data(), p.data.data() + offset, out.size());
+        }
+        s.lru.splice(s.lru.begin(), s.lru, it->second);
+        return true;
+    }
+
+    void caching_target::insert(std::uintptr_t page_address, bool readable, std::span<const std::byte> data) {
+        auto& s = shard_of(page_address);
+        std::lock_guard lock(s.mutex);
+
+        auto it = s.index.find(page_address);
+        if (it != s.index.end()) {
+            s.lru.splice(s.lru.begin(), s.lru, it->second);
+        } else {
+            // the least recently used page makes room, its node is reused for the new one
+            if (s.lru.size() >= m_pages_per_shard) {
+                s.index.erase(s.lru.back().address);
+                s.lru.splice(s.lru.begin(), s.lru, std::prev(s.lru.end()));
+            } else {
+                s.lru.emplace_front();
+            }
+            s.index[page_address] = s.lru.begin();
+        }
+
+        auto& p = s.lru.front();
+        p.address = page_address;
+        p.generation = m_generation.load(std::memory_order_relaxed);
+        p.read_at = clock::now();
+        p.readable = readable;
+        if (readable) {
+            std::memcpy(p.data.data(), data.data(), page_size);
+        }
+    }
+
+    void caching_target::drop(std::uintptr_t address, std::size_t size) {
+        if (size == 0)
+            return;
+        const std::uintptr_t first = address / page_size * page_size;
+        for (std::uintptr_t at = first; at < address + size; at += page_size) {
+            auto& s = shard_of(at);
+            std::lock_guard lock(s.mutex);
+            if (auto it = s.index.find(at); it != s.index.end()) {
+                s.lru.erase(it->second);
+                s.index.erase(it);
+            }
+        }
+    }
+
+    std::expected<void, error_code> caching_target::read_memory(std::uintptr_t address, std::span<std::byte> buffer) {
+        if (!m_inner)
+            return std::unexpected(error_code::process_not_found);
+
+        const read_request request{address, buffer};
+        std::uint8_t readable = 0;
+        read_memory_batch(std::span(&request, 1), std::span(&readable, 1));
+        if (!readable)
+            return std::unexpected(error_code::read_failed);
+        return {};
+    }
+
+    std::size_t caching_target::batch_calls(std::size_t requests) const {
+        return m_inner ? m_inner->batch_calls(requests) : 0;
+    }
+
+    std::size_t
+    caching_target::read_memory_batch(std::span<const read_request> requests, std::span<std::uint8_t> readable) {
+        if (!m_inner) {
+            std::ranges::fill(readable, std::uint8_t{0});
+            return 0;
+        }
+        if (!m_inner->is_live())
+            return m_inner->read_memory_batch(requests, readable);
+
+        std::vector<std::uint8_t> ok(requests.size(), 1);
+        std::vector<read_request> direct;
+        std::vector<std::size_t> direct_owner;
+        std::vector<std::uintptr_t> misses;
+        std::unordered_map<std::uintptr_t, std::size_t> miss_index;
+        std::vector<pending_piece> pending;
+
+        // what the cache holds is copied out right away, the pages it doesn't are collected to be read in one batch
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            const auto& r = requests[i];
+            if (r.buffer.empty())
+                continue;
+
+            const std::uintptr_t first = r.address / page_size * page_size;
+            const std::size_t pages = (r.address + r.buffer.size() - first + page_size - 1) / page_size;
+            if (pages > max_read_pages) {
+                direct.push_back(r);
+                direct_owner.push_back(i);
+                continue;
+            }
+
+            for (std::size_t k = 0; k < pages && ok[i]; ++k) {
+                const std::uintptr_t page_address = first + k * page_size;
+                const std::uintptr_t from = std::max(r.address, page_address);
+                const std::uintptr_t to = std::min(r.address + r.buffer.size(), page_address + page_size);
+                const auto piece = r.buffer.subspan(from - r.address, to - from);
+
+                bool page_readable = false;
+                if (lookup(page_address, piece, from - page_address, page_readable)) {
+                    m_hits.fetch_add(1, std::memory_order_relaxed);
+                    ok[i] = page_readable;
+                    continue;
+                }
+
+                const auto [miss, added] = miss_index.try_emplace(page_address, misses.size());
+                if (added) {
+                    misses.push_back(page_address);
+                }
+                pending.push_back({i, from - r.address, miss->second, from - page_address, to - from});
+            }
+        }
+
+        if (!misses.empty()) {
+            m_misses.fetch_add(misses.size(), std::memory_order_relaxed);
+
+            std::vector<std::byte> data(misses.size() * page_size);
+            std::vector<read_request> page_reads;
+            page_reads.reserve(misses.size());
+            for (std::size_t m = 0; m < misses.size(); ++m) {
+                page_reads.push_back({misses[m], std::span(data).subspan(m * page_size, page_size)});
+            }
+            std::vector<std::uint8_t> page_ok(misses.size());
+            m_inner->read_memory_batch(page_reads, page_ok);
+
+            for (std::size_t m = 0; m < misses.size(); ++m) {
+                insert(misses[m], page_ok[m], page_reads[m].buffer);
+            }
+            for (const auto& p : pending) {
+                if (!page_ok[p.miss]) {
+                    ok[p.request] = 0;
+                    continue;
+                }
+                std::memcpy(
+                        requests[p.request].buffer.data() + p.offset, data.data() + p.miss * page_size + p.page_offset,
+                        p.size
+                );
+            }
+        }
+
+        if (!direct.empty()) {
+            std::vector<std::uint8_t> direct_ok(direct.size());
+            m_inner->read_memory_batch(direct, direct_ok);
+            for (std::size_t d = 0; d < direct.size(); ++d) {
+                ok[direct_owner[d]] = direct_ok[d];
+            }
+        }
+
+        std::size_t done = 0;
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            if (!readable.empty()) {
+                readable[i] = ok[i];
+            }
+            done += ok[i];
+        }
+        return done;
+    }
+
+    std::size_t caching_target::read_prefix(std::uintptr_t address, std::span<std::byte> buffer) {
+        if (!m_inner)
+            return 0;
+        if (!m_inner->is_live())
+            return m_inner->read_prefix(address, buffer);
+
+        // a request per page, the prefix ends at the first one that can't be read
+        std::vector<read_request> pages;
+        for (std::size_t offset = 0; offset < buffer.size();) {
+            const std::size_t piece = std::min(buffer.size() - offset, page_size - (address + offset) % page_size);
+            pages.push_back({address + offset, buffer.subspan(offset, piece)});
+            offset += piece;
+        }
+        std::vector<std::uint8_t> ok(pages.size());
+        read_memory_batch(pages, ok);
+
+        std::size_t done = 0;
+        for (std::size_t k = 0; k < pages.size() && ok[k]; ++k) {
+            done += pages[k].buffer.size();
+        }
+        return done;
+    }
+
+    std::expected<void, error_code>
+    caching_target::write_memory(std::uintptr_t address, std::span<const std::byte> buffer) {
+        if (!m_inner)
+            return std::unexpected(error_code::process_not_found);
+        drop(address, buffer.size());
+        return m_inner->write_memory(address, buffer);
+    }
+
+    std::size_t caching_target::write_memory_batch(std::span<const write_request> requests) {
+        if (!m_inner)
+            return 0;
+        for (const auto& r : requests) {
+            drop(r.address, r.buffer.size());
+        }
+        return m_inner->write_memory_batch(requests);
+    }
+
+    std::optional<std::span<const std::byte>> caching_target::view_memory(std::uintptr_t address, std::size_t size) {
+        if (!m_inner)
+            return std::nullopt;
+        return m_inner->view_memory(address, size);
+    }
+
+    void caching_target::data_runs(std::uintptr_t address, std::size_t size, std::vector<memory_run>& runs) {
+        if (m_inner) {
+            m_inner->data_runs(address, size, runs);
+        } else {
+            runs.assign(1, {address, size});
+        }
+    }
+
+    void caching_target::advise(std::uintptr_t address, std::size_t size, access_pattern pattern) {
+        if (m_inner) {
+            m_inner->advise(address, size, pattern);
+        }
+    }
+
+    std::expected<std::vector<memory_region>, error_code> caching_target::get_memory_regions() {
+        if (!m_inner)
+            return std::unexpected(error_code::process_not_found);
+        return m_inner->get_memory_regions();
+    }
+
+    std::expected<std::shared_ptr<const region_table>, error_code> caching_target::get_region_table() {
+        if (!m_inner)
+            return std::unexpected(error_code::process_not_found);
+        return m_inner->get_region_table();
+    }
+
+    bool caching_target::is_live() const {
+        return m_inner && m_inner->is_live();
+    }
+
+    std::string caching_target::get_name() const {
+        return m_inner ? m_inner->get_name() : std::string{};
+    }
+
+    std::optional<std::uintptr_t> caching_target::get_entry_point() const {
+        return m_inner ? m_inner->get_entry_point() : std::nullopt;
+    }
+
+    std::optional<std::uint32_t> caching_target::sync_dirty() {
+        return m_inner ? m_inner->sync_dirty() : std::nullopt;
+    }
+
+    bool caching_target::written_since(std::uintptr_t address, std::size_t size, std::uint32_t generation) const {
+        return !m_inner || m_inner->written_since(address, size, generation);
+    }
+
+    std::expected<void, error_code>
+    caching_target::resident_pages(std::uintptr_t address, std::size_t size, std::span<std::uint64_t> bits) {
+        if (!m_inner)
+            return std::unexpected(error_code::not_supported);
+        return m_inner->resident_pages(address, size, bits);
+    }
+} // namespace core
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <core/target.h>
+
+namespace core {
+    struct page_cache_stats {
+        std::uint64_t hits = 0;   // pages served from the cache
+        std::uint64_t misses = 0; // pages read from the target
+        std::size_t pages = 0;    // pages held now
+    };
+
+    // keeps pages of a live target in memory for the views, which read the same few pages every frame. a page is read
+    // again once max_age has passed since it was read, and all of them after invalidate or a new target. writes go
+    // through and drop the pages they touch. reads spanning more than max_read_pages, and everything on targets
+    // that aren't live, pass straight through
+    class caching_target final : public target {
+    public:
+        static constexpr std::size_t default_budget = 4 * 1024 * 1024;
+        static constexpr std::chrono::milliseconds default_max_age{100};
+        static constexpr std::size_t max_read_pages = 16;
+
+        explicit caching_target(
+                target* inner, std::size_t byte_budget = default_budget,
+                std::chrono::milliseconds max_age = default_max_age
+        );
+
+        caching_target(const caching_target&) = delete;
+        caching_target& operator=(const caching_target&) = delete;
+        caching_target(caching_target&&) = delete;
+        caching_target& operator=(caching_target&&) = delete;
+
+        // drops every page, they belong to the previous target
+        void set_target(target* inner);
+        [[nodiscard]] target* inner() const {
+            return m_inner;
+        }
+
+        // every page is read again the next time it is asked for
+        void invalidate();
+        void set_max_age(std::chrono::milliseconds max_age);
+        [[nodiscard]] page_cache_stats stats() const;
+
+        [[nodiscard]] std::expected<void, error_code>
+        read_memory(std::uintptr_t address, std::span<std::byte> buffer) override;
+        std::size_t
+        read_memory_batch(std::span<const read_request> requests, std::span<std::uint8_t> readable = {}) override;
+        [[nodiscard]] std::size_t batch_calls(std::size_t requests) const override;
+        [[nodiscard]] std::size_t read_prefix(std::uintptr_t address, std::span<std::byte> buffer) override;
+        [[nodiscard]] std::expected<void, error_code>
+        write_memory(std::uintptr_t address, std::span<const std::byte> buffer) override;
+        [[nodiscard]] std::size_t write_memory_batch(std::span<const write_request> requests) override;
+        [[nodiscard]] std::optional<std::span<const std::byte>>
+        view_memory(std::uintptr_t address, std::size_t size) override;
+        void data_runs(std::uintptr_t address, std::size_t size, std::vector<memory_run>& runs) override;
+        void advise(std::uintptr_t address, std::size_t size, access_pattern pattern) override;
+        [[nodiscard]] std::expected<std::vector<memory_region>, error_code> get_memory_regions() override;
+        [[nodiscard]] std::expected<std::shared_ptr<const region_table>, error_code> get_region_table() override;
+        [[nodiscard]] bool is_live() const override;
+        [[nodiscard]] std::string get_name() const override;
+        [[nodiscard]] std::optional<std::uintptr_t> get_entry_point() const override;
+
+        [[nodiscard]] std::optional<std::uint32_t> sync_dirty() override;
+        [[nodiscard]] bool
+        written_since(std::uintptr_t address, std::size_t size, std::uint32_t generation) const override;
+        [[nodiscard]] std::expected<void, error_code>
+        resident_pages(std::uintptr_t address, std::size_t size, std::span<std::uint64_t> bits) override;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        struct page {
+            std::uintptr_t address = 0;
+            std::uint64_t generation = 0;
+            clock::time_point read_at;
+            bool readable = false;
+            std::array<std::byte, page_size> data;
+        };
+
+        // pages spread over the shards by address, each with its own lock and its own share of the budget
+        struct shard {
+            mutable std::mutex mutex;
+            std::list<page> lru; // most recently used first
+            std::unordered_map<std::uintptr_t, std::list<page>::iterator> index;
+        };
+
+        static constexpr std::size_t shard_count = 8;
+
+        shard& shard_of(std::uintptr_t page_address);
+        // copies the page into out when it is cached and current. false when it has to be read
+        bool lookup(std::uintptr_t page_address, std::span<std::byte> out, std::size_t offset, bool& readable);
+        void insert(std::uintptr_t page_address, bool readable, std::span<const std::byte> data);
+        void drop(std::uintptr_t address, std::size_t size);
+
+        target* m_inner = nullptr;
+        std::array<shard, shard_count> m_shards;
+        std::size_t m_pages_per_shard = 1;
+        std::atomic<std::uint64_t> m_generation = 0;
+        std::atomic<std::int64_t> m_max_age_ms;
+
+        std::atomic<std::uint64_t> m_hits = 0;
+        std::atomic<std::uint64_t> m_misses = 0;
+    };
+} // namespace core
@@ -3,71 +3,75 @@
 #include <core/parsers/elf_parser.h>
 #include <core/parsers/pe_parser.h>
 
+#include <algorithm>
 #include <cstring>
-#include <fstream>
-#include <iterator>
 
 namespace core {
-    namespace {
-        std::expected<std::vector<std::byte>, error_code> read_file_bytes(const std::filesystem::path& path) {
-            std::ifstream file(path, std::ios::binary | std::ios::ate);
-            if (!file) {
-                return std::unexpected(error_code::read_failed);
-            }
-            std::streamsize size = file.tellg();
-            file.seekg(0, std::ios::beg);
-            std::vector<std::byte> buffer(static_cast<std::size_t>(size));
-            if (file.read(reinterpret_cast<char*>(buffer.data()), size)) {
-                return buffer;
-            }
-            return std::unexpected(error_code::read_failed);
-        }
-    } // namespace
-
     std::expected<file_target, error_code> file_target::create(const std::filesystem::path& path) {
-        auto file_data_res = read_file_bytes(path);
-        if (!file_data_res) {
-            return std::unexpected(file_data_res.error());
+        auto file = mapped_region::open(path);
+        if (!file) {
+            return std::unexpected(file.error());
         }
-        std::vector<std::byte> file_data = std::move(*file_data_res);
-        std::span<const std::byte> data_span = file_data;
+        std::span<const std::byte> data_span = file->bytes();
 
         // try pe parser
         if (auto pe_res = pe_parser::create(path, data_span)) {
-            return file_target(std::move(file_data), std::make_unique<pe_parser>(std::move(*pe_res)));
+            return file_target(std::move(*file), std::make_unique<pe_parser>(std::move(*pe_res)));
         }
 
         // try elf parser
         if (auto elf_res = elf_parser::create(path, data_span)) {
-            return file_target(std::move(file_data), std::make_unique<elf_parser>(std::move(*elf_res)));
+            return file_target(std::move(*file), std::make_unique<elf_parser>(std::move(*elf_res)));
         }
 
         return std::unexpected(error_code::read_failed); // unsupported format
     }
 
-    file_target::file_target(std::vector<std::byte> data, std::unique_ptr<binary_parser> parser) :
-        m_file_data(std::move(data)), m_parser(std::move(parser)) {
+    file_target::file_target(mapped_region file, std::unique_ptr<binary_parser> parser) :
+        m_file(std::move(file)), m_parser(std::move(parser)) {
     }
 
     std::expected<void, error_code> file_target::read_memory(std::uintptr_t address, std::span<std::byte> buffer) {
-        auto file_offset_opt = m_parser->virtual_to_file_offset(address);
-        if (!file_offset_opt) {
+        const std::size_t done = read_prefix(address, buffer);
+        if (done == 0 && !buffer.empty()) {
             return std::unexpected(error_code::invalid_address);
         }
-        std::size_t file_offset = *file_offset_opt;
-
-        if (file_offset >= m_file_data.size()) {
-            return std::unexpected(error_code::invalid_address);
+        if (done < buffer.size()) {
+            return std::unexpected(error_code::partial_read);
         }
+        return {};
+    }
 
-        std::size_t bytes_to_read = std::min(buffer.size(), m_file_data.size() - file_offset);
-
-        std::memcpy(buffer.data(), m_file_data.data() + file_offset, bytes_to_read);
+    std::size_t file_target::read_prefix(std::uintptr_t address, std::span<std::byte> buffer) {
+        // run by run, so a read crossing into the next section or a zero filled tail gets what is mapped there
+        const auto data = file_data();
+        std::size_t done = 0;
+        while (done < buffer.size()) {
+            const auto run = m_parser->index().run_at(address + done, buffer.size() - done);
+            if (!run)
+                break;
+
+            if (run->offset) {
+                std::memcpy(buffer.data() + done, data.data() + *run->offset, run->size);
+            } else {
+                std::memset(buffer.data() + done, 0, run->size);
+            }
+            done += run->size;
+        }
+        return done;
+    }
 
-        if (bytes_to_read < buffer.size()) {
-            return std::unexpected(error_code::partial_read);
+    std::size_t
+    file_target::read_memory_batch(std::span<const read_request> requests, std::span<std::uint8_t> readable) {
+        std::size_t done = 0;
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            const bool read = read_memory(requests[i].address, requests[i].buffer).has_value();
+            if (!readable.empty()) {
+                readable[i] = read;
+            }
+            done += read;
         }
-        return {};
+        return done;
     }
 
     std::expected<void, error_code>
@@ -75,6 +79,38 @@ namespace core {
         return std::unexpected(error_code::permission_denied); // cannot write to file target
     }
 
+    std::optional<std::span<const std::byte>> file_target::view_memory(std::uintptr_t address, std::size_t size) {
+        // only the bytes the mapping itself has in the file, the rest is left to read_memory
+        auto range = m_parser->virtual_to_file_range(address);
+        const auto data = file_data();
+        if (!range || size > range->size || range->offset > data.size() || size > data.size() - range->offset) {
+            return std::nullopt;
+        }
+        return data.subspan(range->offset, size);
+    }
+
+    void file_target::data_runs(std::uintptr_t address, std::size_t size, std::vector<memory_run>& runs) {
+        runs.clear();
+        thread_local std::vector<file_run> mapped;
+        m_parser->index().runs(address, size, mapped);
+        for (const auto& run : mapped) {
+            if (!run.offset)
+                continue;
+            if (!runs.empty() && runs.back().address + runs.back().size == run.address) {
+                runs.back().size += run.size;
+            } else {
+                runs.push_back({run.address, run.size});
+            }
+        }
+    }
+
+    void file_target::advise(std::uintptr_t address, std::size_t size, access_pattern pattern) {
+        // regions are one mapping each, so the start alone tells where in the file the range lies
+        if (auto range = m_parser->virtual_to_file_range(address)) {
+            m_file.advise(range->offset, std::min(size, range->size), pattern);
+        }
+    }
+
     std::expected<std::vector<memory_region>, error_code> file_target::get_memory_regions() {
         return m_parser->get_sections();
     }
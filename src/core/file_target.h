@@ -9,6 +9,7 @@
 #include <core/parsers/binary_parser.h>
 #include <core/target.h>
 #include <util/expected.h>
+#include <util/mapped_file.h>
 
 namespace core {
     class file_target final : public target {
@@ -20,8 +21,15 @@ namespace core {
 
         [[nodiscard]] std::expected<void, error_code>
         read_memory(std::uintptr_t address, std::span<std::byte> buffer) override;
+        std::size_t
+        read_memory_batch(std::span<const read_request> requests, std::span<std::uint8_t> readable = {}) override;
+        [[nodiscard]] std::size_t read_prefix(std::uintptr_t address, std::span<std::byte> buffer) override;
         [[nodiscard]] std::expected<void, error_code>
         write_memory(std::uintptr_t address, std::span<const std::byte> buffer) override;
+        [[nodiscard]] std::optional<std::span<const std::byte>>
+        view_memory(std::uintptr_t address, std::size_t size) override;
+        void data_runs(std::uintptr_t address, std::size_t size, std::vector<memory_run>& runs) override;
+        void advise(std::uintptr_t address, std::size_t size, access_pattern pattern) override;
         [[nodiscard]] std::expected<std::vector<memory_region>, error_code> get_memory_regions() override;
         [[nodiscard]] bool is_live() const override;
         [[nodiscard]] std::string get_name() const override;
@@ -32,9 +40,14 @@ namespace core {
         }
 
     private:
-        file_target(std::vector<std::byte> data, std::unique_ptr<binary_parser> parser);
+        file_target(mapped_region file, std::unique_ptr<binary_parser> parser);
 
-        std::vector<std::byte> m_file_data;
+        [[nodiscard]] std::span<const std::byte> file_data() const {
+            return m_file.bytes();
+        }
+
+        // the file is mapped rather than read, opening costs the same at any size and only what is touched is paged in
+        mapped_region m_file;
         std::unique_ptr<binary_parser> m_parser;
     };
 } // namespace core
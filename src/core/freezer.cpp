@@ -0,0 +1,194 @@
+#include <core/freezer.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace core {
+    freezer::freezer(target* t) : active_target(t), thread([this](std::stop_token stop) { worker(stop); }) {
+    }
+
+    freezer::~freezer() = default;
+
+    void freezer::set_target(target* t) {
+        thread.request_stop();
+        thread.join();
+
+        {
+            std::lock_guard lock(values_mutex);
+            values.clear();
+            ++values_version;
+        }
+        active_target = t;
+        reset_stats();
+
+        thread = std::jthread([this](std::stop_token stop) { worker(stop); });
+    }
+
+    void freezer::freeze(std::uintptr_t address, std::span<const std::byte> value, std::uint8_t tag) {
+        {
+            std::lock_guard lock(values_mutex);
+            auto it = std::ranges::lower_bound(values, address, {}, &frozen_value::address);
+            if (it != values.end() && it->address == address) {
+                it->value.assign(value.begin(), value.end());
+                it->tag = tag;
+            } else {
+                values.insert(it, {address, {value.begin(), value.end()}, tag});
+            }
+            ++values_version;
+        }
+        values_changed.notify_all();
+    }
+
+    void freezer::unfreeze(std::uintptr_t address) {
+        {
+            std::lock_guard lock(values_mutex);
+            auto it = std::ranges::lower_bound(values, address, {}, &frozen_value::address);
+            if (it == values.end() || it->address != address)
+                return;
+            values.erase(it);
+            ++values_version;
+        }
+        values_changed.notify_all();
+    }
+
+    void freezer::clear() {
+        {
+            std::lock_guard lock(values_mutex);
+            values.clear();
+            ++values_version;
+        }
+        values_changed.notify_all();
+    }
+
+    std::vector<frozen_value> freezer::entries() const {
+        std::lock_guard lock(values_mutex);
+        return values;
+    }
+
+    bool freezer::is_frozen(std::uintptr_t address) const {
+        std::lock_guard lock(values_mutex);
+        return std::ranges::binary_search(values, address, {}, &frozen_value::address);
+    }
+
+    void freezer::set_rate(double hz) {
+        rate_hz = std::clamp(hz, 1.0, max_rate);
+    }
+
+    double freezer::rate() const {
+        return rate_hz;
+    }
+
+    freeze_stats freezer::stats() const {
+        freeze_stats s;
+        s.ticks = ticks.load(std::memory_order_relaxed);
+        s.late_ticks = late_ticks.load(std::memory_order_relaxed);
+        s.rewrites = rewrites.load(std::memory_order_relaxed);
+        s.failures = failures.load(std::memory_order_relaxed);
+        s.last_ns = last_ns.load(std::memory_order_relaxed);
+        s.mean_ns = s.ticks > 0 ? total_ns.load(std::memory_order_relaxed) / s.ticks : 0;
+        s.max_ns = max_ns.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void freezer::reset_stats() {
+        ticks = 0;
+        late_ticks = 0;
+        rewrites = 0;
+        failures = 0;
+        last_ns = 0;
+        total_ns = 0;
+        max_ns = 0;
+    }
+
+    void freezer::worker(std::stop_token stop) {
+        using clock = std::chrono::steady_clock;
+
+        // the values as of the last change, with every read going into one buffer so a tick is a single batch
+        std::vector<frozen_value> held;
+        std::uint64_t held_version = 0;
+        std::vector<std::byte> current;
+        std::vector<read_request> reads;
+        std::vector<std::uint8_t> readable;
+        std::vector<write_request> writes;
+        auto next_tick = clock::now();
+
+        while (!stop.stop_requested()) {
+            bool changed = false;
+            {
+                std::unique_lock lock(values_mutex);
+                if (!active_target || values.empty()) {
+                    if (!values_changed.wait(lock, stop, [&] { return active_target && !values.empty(); }))
+                        return;
+                    next_tick = clock::now();
+                }
+                if (held_version != values_version) {
+                    held = values;
+                    held_version = values_version;
+                    changed = true;
+                }
+            }
+
+            if (changed) {
+                std::size_t total = 0;
+                for (const auto& v : held) {
+                    total += v.value.size();
+                }
+                current.resize(total);
+                readable.resize(held.size());
+
+                reads.clear();
+                std::size_t offset = 0;
+                for (const auto& v : held) {
+                    reads.push_back({v.address, std::span(current).subspan(offset, v.value.size())});
+                    offset += v.value.size();
+                }
+            }
+
+            const auto start = clock::now();
+
+            // a value that can't be read sits this tick out, the batch goes on past it
+            std::uint64_t failed = reads.size() - active_target->read_memory_batch(reads, readable);
+
+            // only values that drifted get written, most ticks of a quiet target write nothing at all
+            writes.clear();
+            for (std::size_t i = 0; i < held.size(); ++i) {
+                if (readable[i] && !std::ranges::equal(reads[i].buffer, held[i].value)) {
+                    writes.push_back({held[i].address, held[i].value});
+                }
+            }
+
+            std::uint64_t written = writes.size();
+            for (std::size_t done = 0; done < writes.size();) {
+                done += active_target->write_memory_batch(std::span(writes).subspan(done));
+                if (done < writes.size()) {
+                    ++done;
+                    ++failed;
+                    --written;
+                }
+            }
+
+            const auto elapsed = static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count()
+            );
+            ticks.fetch_add(1, std::memory_order_relaxed);
+            rewrites.fetch_add(written, std::memory_order_relaxed);
+            failures.fetch_add(failed, std::memory_order_relaxed);
+            last_ns.store(elapsed, std::memory_order_relaxed);
+            total_ns.fetch_add(elapsed, std::memory_order_relaxed);
+            for (auto seen = max_ns.load(std::memory_order_relaxed);
+                 elapsed > seen && !max_ns.compare_exchange_weak(seen, elapsed, std::memory_order_relaxed);) {
+            }
+
+            // a tick that ran past the next one's start lets it go right away, missed ticks aren't made up for
+            next_tick += std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / rate_hz));
+            if (const auto now = clock::now(); next_tick < now) {
+                late_ticks.fetch_add(1, std::memory_order_relaxed);
+                next_tick = now;
+            }
+
+            // a change to the values ends the wait, so it is written from the next tick on rather than a period later
+            std::unique_lock lock(values_mutex);
+            values_changed.wait_until(lock, stop, next_tick, [&] { return values_version != held_version; });
+        }
+    }
+} // namespace core
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <vector>
+#include "core/target.h"
+
+namespace core {
+    struct frozen_value {
+        std::uintptr_t address = 0;
+        std::vector<std::byte> value;
+        std::uint8_t tag = 0; // what the value is, up to whoever froze it
+    };
+
+    // a tick reads every frozen value in one batch and writes back the ones that drifted in another. times are in
+    // nanoseconds
+    struct freeze_stats {
+        std::uint64_t ticks = 0;
+        std::uint64_t late_ticks = 0; // started after the tick following them was already due
+        std::uint64_t rewrites = 0;   // values written back after something changed them
+        std::uint64_t failures = 0;   // values that couldn't be read or written
+        std::uint64_t last_ns = 0;
+        std::uint64_t mean_ns = 0;
+        std::uint64_t max_ns = 0;
+    };
+
+    // holds addresses at fixed values from a thread of its own, which sleeps while nothing is frozen
+    class freezer {
+    public:
+        static constexpr double default_rate = 100.0;
+        static constexpr double max_rate = 10'000.0;
+
+        explicit freezer(target* t);
+        ~freezer();
+
+        freezer(const freezer&) = delete;
+        freezer& operator=(const freezer&) = delete;
+        freezer(freezer&&) = delete;
+        freezer& operator=(freezer&&) = delete;
+
+        // drops every frozen value, they belong to the previous target. returns once the thread is done with it
+        void set_target(target* t);
+
+        // holds address at value from the next tick on, replacing whatever was frozen at that address
+        void freeze(std::uintptr_t address, std::span<const std::byte> value, std::uint8_t tag = 0);
+        void unfreeze(std::uintptr_t address);
+        void clear();
+
+        [[nodiscard]] std::vector<frozen_value> entries() const;
+        [[nodiscard]] bool is_frozen(std::uintptr_t address) const;
+
+        // ticks per second, clamped to [1, max_rate]
+        void set_rate(double hz);
+        [[nodiscard]] double rate() const;
+
+        [[nodiscard]] freeze_stats stats() const;
+        void reset_stats();
+
+    private:
+        void worker(std::stop_token stop);
+
+        target* active_target;
+
+        std::vector<frozen_value> values; // sorted by address
+        std::uint64_t values_version = 0;
+        mutable std::mutex values_mutex;
+        std::condition_variable_any values_changed;
+
+        std::atomic<double> rate_hz = default_rate;
+
+        std::atomic<std::uint64_t> ticks = 0;
+        std::atomic<std::uint64_t> late_ticks = 0;
+        std::atomic<std::uint64_t> rewrites = 0;
+        std::atomic<std::uint64_t> failures = 0;
+        std::atomic<std::uint64_t> last_ns = 0;
+        std::atomic<std::uint64_t> total_ns = 0;
+        std::atomic<std::uint64_t> max_ns = 0;
+
+        std::jthread thread;
+    };
+} // namespace core
@@ -0,0 +1,109 @@
+#include <core/io_budget.h>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace core {
+    namespace {
+        // long waits are slept off in slices so cancelling doesn't have to sit them out
+        constexpr std::chrono::milliseconds wait_slice{10};
+
+        double capacity(double rate) {
+            return rate * std::chrono::duration<double>(io_budget::burst).count();
+        }
+    } // namespace
+
+    io_budget::io_budget(const io_budget& other) {
+        set_limits(other.limits());
+    }
+
+    io_budget& io_budget::operator=(const io_budget& other) {
+        if (this != &other) {
+            set_limits(other.limits());
+        }
+        return *this;
+    }
+
+    void io_budget::set_limits(io_limits limits) {
+        std::lock_guard lock(mutex);
+        const auto byte_rate = static_cast<double>(limits.bytes_per_second);
+        const auto call_rate = static_cast<double>(limits.calls_per_second);
+        bytes_bucket = {byte_rate, capacity(byte_rate)};
+        calls_bucket = {call_rate, capacity(call_rate)};
+        last_refill = clock::now();
+        limited = limits.bytes_per_second > 0 || limits.calls_per_second > 0;
+        current = std::move(limits);
+    }
+
+    io_limits io_budget::limits() const {
+        std::lock_guard lock(mutex);
+        return current;
+    }
+
+    std::vector<std::uint32_t> io_budget::cpus() const {
+        std::lock_guard lock(mutex);
+        return current.cpus;
+    }
+
+    bool io_budget::is_limited() const {
+        return limited;
+    }
+
+    bool io_budget::acquire(std::size_t bytes, std::size_t calls, const std::atomic<bool>& cancel) {
+        if (!limited)
+            return !cancel;
+        return wait(take(bytes, calls), [&] { return cancel.load(); });
+    }
+
+    bool io_budget::acquire(std::size_t bytes, std::size_t calls, std::stop_token stop) {
+        if (!limited)
+            return !stop.stop_requested();
+        return wait(take(bytes, calls), [&] { return stop.stop_requested(); });
+    }
+
+    std::uint64_t io_budget::throttled_ns() const {
+        return waited_ns;
+    }
+
+    io_budget::clock::duration io_budget::take(std::size_t bytes, std::size_t calls) {
+        std::lock_guard lock(mutex);
+
+        const auto now = clock::now();
+        const double elapsed = std::chrono::duration<double>(now - last_refill).count();
+        last_refill = now;
+
+        double seconds = 0.0;
+        for (auto [b, amount] : {std::pair{&bytes_bucket, bytes}, std::pair{&calls_bucket, calls}}) {
+            if (b->rate <= 0.0)
+                continue;
+            b->tokens = std::min(capacity(b->rate), b->tokens + elapsed * b->rate) - static_cast<double>(amount);
+            if (b->tokens < 0.0) {
+                seconds = std::max(seconds, -b->tokens / b->rate);
+            }
+        }
+        return std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(seconds));
+    }
+
+    template <typename Cancelled>
+    bool io_budget::wait(clock::duration debt, Cancelled cancelled) {
+        if (debt <= clock::duration::zero())
+            return !cancelled();
+
+        const auto start = clock::now();
+        const auto until = start + debt;
+        bool finished = true;
+        for (auto now = start; now < until; now = clock::now()) {
+            if (cancelled()) {
+                finished = false;
+                break;
+            }
+            std::this_thread::sleep_for(std::min<clock::duration>(until - now, wait_slice));
+        }
+
+        waited_ns += static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count()
+        );
+        return finished && !cancelled();
+    }
+} // namespace core
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <vector>
+
+namespace core {
+    struct io_limits {
+        std::uint64_t bytes_per_second = 0; // 0 for no limit
+        std::uint64_t calls_per_second = 0; // reads, a batch counting as the calls it takes. 0 for no limit
+        std::vector<std::uint32_t> cpus;    // where scan threads run while they read the target, anywhere when empty
+
+        bool operator==(const io_limits&) const = default;
+    };
+
+    // how much reading the analyzers of one target may do, as token buckets for bytes and calls that refill at the
+    // configured rates and hold up to burst worth of them. a read takes what it needs up front and waits out the
+    // debt it leaves, so the readers sharing a budget queue up behind each other in the order they asked
+    class io_budget {
+    public:
+        static constexpr std::chrono::milliseconds burst{100};
+
+        io_budget() = default;
+        // copies take the limits along and start out with full buckets, for targets moved into place
+        io_budget(const io_budget& other);
+        io_budget& operator=(const io_budget& other);
+
+        void set_limits(io_limits limits);
+        [[nodiscard]] io_limits limits() const;
+        [[nodiscard]] std::vector<std::uint32_t> cpus() const;
+        [[nodiscard]] bool is_limited() const;
+
+        // takes bytes and calls from the buckets and waits until they are paid for. returns false once cancel is
+        // set or stop is requested, the waiting cut short
+        bool acquire(std::size_t bytes, std::size_t calls, const std::atomic<bool>& cancel);
+        bool acquire(std::size_t bytes, std::size_t calls, std::stop_token stop);
+
+        // time readers spent waiting on the budget, in nanoseconds
+        [[nodiscard]] std::uint64_t throttled_ns() const;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        struct bucket {
+            double rate = 0.0; // tokens per second, 0 when unlimited
+            double tokens = 0.0;
+        };
+
+        // the wait the request leaves behind, zero when the buckets covered it
+        clock::duration take(std::size_t bytes, std::size_t calls);
+        template <typename Cancelled>
+        bool wait(clock::duration debt, Cancelled cancelled);
+
+        mutable std::mutex mutex;
+        io_limits current;
+        bucket bytes_bucket;
+        bucket calls_bucket;
+        clock::time_point last_refill = clock::now();
+        std::atomic<bool> limited = false;
+        std::atomic<std::uint64_t> waited_ns = 0;
+    };
+} // namespace core
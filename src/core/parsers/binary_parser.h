@@ -5,8 +5,10 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <core/parsers/section_index.h>
 #include <core/target.h>
 #include <util/expected.h>
 
@@ -17,9 +19,31 @@ namespace core {
 
         [[nodiscard]] virtual std::vector<memory_region> get_sections() const = 0;
         [[nodiscard]] virtual std::optional<std::uintptr_t> get_entry_point() const = 0;
-        [[nodiscard]] virtual std::optional<std::uintptr_t> virtual_to_file_offset(std::uintptr_t virt_addr) const = 0;
+        // where virt_addr is in the file, when the file holds its byte
+        [[nodiscard]] std::optional<std::uintptr_t> virtual_to_file_offset(std::uintptr_t virt_addr) const {
+            const auto run = m_index.run_at(virt_addr, 1);
+            return run ? run->offset : std::nullopt;
+        }
+        // where virt_addr is in the file and how many bytes from there the file holds for the same mapping
+        [[nodiscard]] std::optional<file_range> virtual_to_file_range(std::uintptr_t virt_addr) const {
+            const auto run = m_index.run_at(virt_addr, SIZE_MAX);
+            if (!run || !run->offset)
+                return std::nullopt;
+            return file_range{*run->offset, run->size};
+        }
+        // the sections as the parser mapped them, for reads that cross or run into zero filled parts
+        [[nodiscard]] const section_index& index() const {
+            return m_index;
+        }
         [[nodiscard]] virtual const std::filesystem::path& get_path() const = 0;
         [[nodiscard]] virtual std::string get_arch_name() const = 0;
         [[nodiscard]] virtual std::string get_type_name() const = 0;
+
+    protected:
+        binary_parser() = default;
+        explicit binary_parser(section_index index) : m_index(std::move(index)) {
+        }
+
+        section_index m_index;
     };
 } // namespace core
@@ -47,12 +47,22 @@ namespace core {
             }
         }
 
-        return elf_parser(std::move(path), header, std::move(segments));
+        // only loadable segments are mapped, the part of one past its file size is zero filled
+        std::vector<section_span> spans;
+        for (const auto& segment : segments) {
+            if (segment.p_type == elf::pt_load && segment.p_memsz > 0) {
+                spans.push_back({segment.p_vaddr, segment.p_memsz, segment.p_offset, segment.p_filesz});
+            }
+        }
+        section_index index(std::move(spans), data.size());
+
+        return elf_parser(std::move(path), header, std::move(segments), std::move(index));
     }
 
     elf_parser::elf_parser(
-            std::filesystem::path path, const elf::elf64_ehdr& header, std::vector<elf::elf64_phdr> segments
-    ) : m_path(std::move(path)), m_header(header), m_segments(std::move(segments)) {
+            std::filesystem::path path, const elf::elf64_ehdr& header, std::vector<elf::elf64_phdr> segments,
+            section_index index
+    ) : binary_parser(std::move(index)), m_path(std::move(path)), m_header(header), m_segments(std::move(segments)) {
     }
 
     std::vector<memory_region> elf_parser::get_sections() const {
@@ -72,20 +82,6 @@ namespace core {
         return m_header.e_entry;
     }
 
-    std::optional<std::uintptr_t> elf_parser::virtual_to_file_offset(std::uintptr_t virt_addr) const {
-        for (const auto& segment : m_segments) {
-            if (segment.p_type == elf::pt_load) {
-                if (virt_addr >= segment.p_vaddr && virt_addr < (segment.p_vaddr + segment.p_memsz)) {
-                    std::uintptr_t offset_in_segment = virt_addr - segment.p_vaddr;
-                    if (offset_in_segment < segment.p_filesz) {
-                        return segment.p_offset + offset_in_segment;
-                    }
-                }
-            }
-        }
-        return std::nullopt;
-    }
-
     std::string elf_parser::get_arch_name() const {
         switch (m_header.e_machine) {
             case 0x3E:
@@ -11,7 +11,6 @@ namespace core {
 
         [[nodiscard]] std::vector<memory_region> get_sections() const override;
         [[nodiscard]] std::optional<std::uintptr_t> get_entry_point() const override;
-        [[nodiscard]] std::optional<std::uintptr_t> virtual_to_file_offset(std::uintptr_t virt_addr) const override;
         [[nodiscard]] const std::filesystem::path& get_path() const override {
             return m_path;
         }
@@ -19,7 +18,10 @@ namespace core {
         [[nodiscard]] std::string get_type_name() const override;
 
     private:
-        elf_parser(std::filesystem::path path, const elf::elf64_ehdr& header, std::vector<elf::elf64_phdr> segments);
+        elf_parser(
+                std::filesystem::path path, const elf::elf64_ehdr& header, std::vector<elf::elf64_phdr> segments,
+                section_index index
+        );
 
         std::filesystem::path m_path;
         elf::elf64_ehdr m_header;
@@ -57,13 +57,25 @@ namespace core {
             section_offset += sizeof(pe::image_section_header);
         }
 
-        return pe_parser(std::move(path), nt_header, std::move(sections));
+        // raw data is padded to the file alignment and the virtual size can run past it, only the overlap of the
+        // two is the section's own bytes and the rest of the virtual size is zero filled
+        std::vector<section_span> spans;
+        for (const auto& section : sections) {
+            spans.push_back(
+                    {nt_header.optional_header.image_base + section.virtual_address, section.misc.virtual_size,
+                     section.pointer_to_raw_data, section.size_of_raw_data}
+            );
+        }
+        section_index index(std::move(spans), data.size());
+
+        return pe_parser(std::move(path), nt_header, std::move(sections), std::move(index));
     }
 
     pe_parser::pe_parser(
             std::filesystem::path path, const pe::image_nt_headers64& nt_header,
-            std::vector<pe::image_section_header> sections
-    ) : m_path(std::move(path)), m_nt_header(nt_header), m_sections(std::move(sections)) {
+            std::vector<pe::image_section_header> sections, section_index index
+    ) : binary_parser(std::move(index)), m_path(std::move(path)), m_nt_header(nt_header),
+        m_sections(std::move(sections)) {
     }
 
     std::vector<memory_region> pe_parser::get_sections() const {
@@ -81,16 +93,6 @@ namespace core {
         return m_nt_header.optional_header.image_base + m_nt_header.optional_header.address_of_entry_point;
     }
 
-    std::optional<std::uintptr_t> pe_parser::virtual_to_file_offset(std::uintptr_t virt_addr) const {
-        std::uintptr_t rva = virt_addr - m_nt_header.optional_header.image_base;
-        for (const auto& section : m_sections) {
-            if (rva >= section.virtual_address && rva < (section.virtual_address + section.misc.virtual_size)) {
-                return (rva - section.virtual_address) + section.pointer_to_raw_data;
-            }
-        }
-        return std::nullopt;
-    }
-
     std::string pe_parser::get_arch_name() const {
         switch (m_nt_header.file_header.machine) {
             case 0x8664:
@@ -10,7 +10,6 @@ namespace core {
 
         [[nodiscard]] std::vector<memory_region> get_sections() const override;
         [[nodiscard]] std::optional<std::uintptr_t> get_entry_point() const override;
-        [[nodiscard]] std::optional<std::uintptr_t> virtual_to_file_offset(std::uintptr_t virt_addr) const override;
         [[nodiscard]] const std::filesystem::path& get_path() const override {
             return m_path;
         }
@@ -20,7 +19,7 @@ namespace core {
     private:
         pe_parser(
                 std::filesystem::path path, const pe::image_nt_headers64& nt_header,
-                std::vector<pe::image_section_header> sections
+                std::vector<pe::image_section_header> sections, section_index index
         );
 
         std::filesystem::path m_path;
@@ -0,0 +1,73 @@
+#include <core/parsers/section_index.h>
+
+#include <algorithm>
+
+namespace core {
+    section_index::section_index(std::vector<section_span> spans, std::size_t file_length) {
+        std::ranges::stable_sort(spans, {}, &section_span::address);
+
+        m_spans.reserve(spans.size());
+        for (auto s : spans) {
+            s.file_size = std::min(s.file_size, s.size);
+            if (s.file_size > 0 && (s.offset >= file_length || s.file_size > file_length - s.offset)) {
+                // a truncated file, what it lacks of the section can't be read or assumed zero
+                s.file_size = s.offset < file_length ? file_length - s.offset : 0;
+                s.size = s.file_size;
+            }
+
+            if (!m_spans.empty()) {
+                const auto end = m_spans.back().address + m_spans.back().size;
+                if (end > s.address) {
+                    const std::size_t cut = std::min<std::size_t>(end - s.address, s.size);
+                    s.address += cut;
+                    s.size -= cut;
+                    s.offset += std::min(cut, s.file_size);
+                    s.file_size -= std::min(cut, s.file_size);
+                }
+            }
+            if (s.size > 0) {
+                m_spans.push_back(s);
+            }
+        }
+    }
+
+    std::vector<section_span>::const_iterator section_index::at_or_after(std::uintptr_t address) const {
+        // the last section starting at or before address holds it, unless it ends first
+        auto it = std::ranges::upper_bound(m_spans, address, {}, &section_span::address);
+        if (it != m_spans.begin() && address - std::prev(it)->address < std::prev(it)->size) {
+            --it;
+        }
+        return it;
+    }
+
+    std::optional<file_run> section_index::run_at(std::uintptr_t address, std::size_t max) const {
+        const auto it = at_or_after(address);
+        if (it == m_spans.end() || it->address > address || max == 0)
+            return std::nullopt;
+
+        const std::size_t into = address - it->address;
+        if (into < it->file_size) {
+            return file_run{address, std::min(max, it->file_size - into), it->offset + into};
+        }
+        return file_run{address, std::min(max, it->size - into), std::nullopt};
+    }
+
+    void section_index::runs(std::uintptr_t address, std::size_t size, std::vector<file_run>& out) const {
+        out.clear();
+        const std::uintptr_t end = address + size;
+        for (auto it = at_or_after(address); it != m_spans.end() && it->address < end; ++it) {
+            std::uintptr_t from = std::max(address, it->address);
+            const std::uintptr_t to = std::min(end, it->address + it->size);
+
+            // the file backed front of the section, then whatever of its zero filled tail is asked for
+            const std::uintptr_t backed_end = std::min(to, it->address + it->file_size);
+            if (from < backed_end) {
+                out.push_back({from, backed_end - from, it->offset + (from - it->address)});
+                from = backed_end;
+            }
+            if (from < to) {
+                out.push_back({from, to - from, std::nullopt});
+            }
+        }
+    }
+} // namespace core
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace core {
+    struct file_range {
+        std::uintptr_t offset = 0;
+        std::size_t size = 0;
+    };
+
+    // a piece of a mapped virtual range, either read from the file at offset or zero filled when there is none
+    struct file_run {
+        std::uintptr_t address = 0;
+        std::size_t size = 0;
+        std::optional<std::uintptr_t> offset;
+    };
+
+    // one section or segment as the parser found it, file_size may be less than size when the rest is zero filled
+    struct section_span {
+        std::uintptr_t address = 0;
+        std::size_t size = 0;
+        std::uintptr_t offset = 0;
+        std::size_t file_size = 0;
+    };
+
+    // sections sorted by address for O(log n) address lookups. built once per parser, never changed afterwards
+    class section_index {
+    public:
+        section_index() = default;
+        // overlapping sections are cut where an earlier one ends, and file bytes past file_length aren't mapped at
+        // all rather than read past the end
+        section_index(std::vector<section_span> spans, std::size_t file_length);
+
+        // the run starting at address, at most max bytes long. empty when nothing is mapped there
+        [[nodiscard]] std::optional<file_run> run_at(std::uintptr_t address, std::size_t max) const;
+        // every run of [address, address + size) in order, holes between sections are left out
+        void runs(std::uintptr_t address, std::size_t size, std::vector<file_run>& out) const;
+
+    private:
+        // the section holding address, or the first one after it
+        [[nodiscard]] std::vector<section_span>::const_iterator at_or_after(std::uintptr_t address) const;
+
+        std::vector<section_span> m_spans; // disjoint, by address
+    };
+} // namespace core
@@ -8,6 +8,9 @@
 #error "unsupported platform"
 #endif
 
+#include <algorithm>
+#include <mutex>
+
 namespace core {
     process::process() {
 #if defined(__linux__)
@@ -29,6 +32,7 @@ namespace core {
         auto result = m_controller->attach(pid);
         if (result.has_value()) {
             m_attached_pid = pid;
+            reset_dirty();
 
             if (auto procs = enumerate_processes()) {
                 for (const auto& p : *procs) {
@@ -47,6 +51,7 @@ namespace core {
             m_controller->detach(m_attached_pid);
             m_attached_pid = 0;
             m_attached_process_name.clear();
+            reset_dirty();
         }
     }
 
@@ -65,6 +70,13 @@ namespace core {
         return m_controller->get_memory_regions(m_attached_pid);
     }
 
+    std::expected<std::shared_ptr<const region_table>, error_code> process::get_region_table() {
+        if (!is_attached()) {
+            return std::unexpected(error_code::process_not_found);
+        }
+        return m_controller->get_region_table(m_attached_pid);
+    }
+
     std::expected<void, error_code> process::read_memory(std::uintptr_t address, std::span<std::byte> buffer) {
         if (!is_attached()) {
             return std::unexpected(error_code::process_not_found);
@@ -72,6 +84,25 @@ namespace core {
         return m_controller->read_memory(m_attached_pid, address, buffer);
     }
 
+    std::size_t process::read_memory_batch(std::span<const read_request> requests, std::span<std::uint8_t> readable) {
+        if (!is_attached()) {
+            std::ranges::fill(readable, std::uint8_t{0});
+            return 0;
+        }
+        return m_controller->read_memory_batch(m_attached_pid, requests, readable);
+    }
+
+    std::size_t process::batch_calls(std::size_t requests) const {
+        return m_controller->batch_calls(requests);
+    }
+
+    std::size_t process::read_prefix(std::uintptr_t address, std::span<std::byte> buffer) {
+        if (!is_attached()) {
+            return 0;
+        }
+        return m_controller->read_prefix(m_attached_pid, address, buffer);
+    }
+
     std::expected<void, error_code> process::write_memory(std::uintptr_t address, std::span<const std::byte> buffer) {
         if (!is_attached()) {
             return std::unexpected(error_code::process_not_found);
@@ -79,6 +110,13 @@ namespace core {
         return m_controller->write_memory(m_attached_pid, address, buffer);
     }
 
+    std::size_t process::write_memory_batch(std::span<const write_request> requests) {
+        if (!is_attached()) {
+            return 0;
+        }
+        return m_controller->write_memory_batch(m_attached_pid, requests);
+    }
+
     bool process::is_live() const {
         return true;
     }
@@ -93,4 +131,84 @@ namespace core {
     std::optional<std::uintptr_t> process::get_entry_point() const {
         return std::nullopt;
     }
+
+    std::optional<std::uint32_t> process::sync_dirty() {
+        auto table = get_region_table();
+        if (!table)
+            return std::nullopt;
+
+        std::unique_lock lock(m_dirty_mutex);
+        const std::uint32_t generation = m_generation + 1;
+
+        std::vector<dirty_region> next;
+        std::vector<std::uint64_t> bits;
+        for (const auto& r : (*table)->entries()) {
+            if (!r.has(perm::read))
+                continue;
+
+            const std::size_t pages = (r.size + page_size - 1) / page_size;
+            bits.resize((pages + 63) / 64);
+            if (!m_controller->read_soft_dirty(m_attached_pid, r.base_address, r.size, bits)) {
+                m_dirty.clear();
+                return std::nullopt;
+            }
+
+            // pages nobody wrote keep the generation they had, new mappings come up written
+            auto& region = next.emplace_back(r.base_address, r.size, std::vector<std::uint32_t>(pages, generation));
+            for (std::size_t page = 0; page < pages; ++page) {
+                if ((bits[page / 64] >> (page % 64)) & 1)
+                    continue;
+                if (const auto* stamp = find_stamp(r.base_address + page * page_size)) {
+                    region.stamps[page] = *stamp;
+                }
+            }
+        }
+
+        // a write landing between reading the bits and clearing them goes unseen until the page is written again
+        if (!m_controller->clear_soft_dirty(m_attached_pid)) {
+            m_dirty.clear();
+            return std::nullopt;
+        }
+
+        m_dirty = std::move(next);
+        m_generation = generation;
+        return generation;
+    }
+
+    bool process::written_since(std::uintptr_t address, std::size_t size, std::uint32_t generation) const {
+        std::shared_lock lock(m_dirty_mutex);
+
+        const std::uintptr_t first = address / page_size * page_size;
+        for (std::uintptr_t page = first; page < address + size; page += page_size) {
+            const auto* stamp = find_stamp(page);
+            if (!stamp || *stamp > generation)
+                return true;
+        }
+        return false;
+    }
+
+    std::expected<void, error_code>
+    process::resident_pages(std::uintptr_t address, std::size_t size, std::span<std::uint64_t> bits) {
+        if (!is_attached()) {
+            return std::unexpected(error_code::process_not_found);
+        }
+        return m_controller->read_residency(m_attached_pid, address, size, bits);
+    }
+
+    const std::uint32_t* process::find_stamp(std::uintptr_t address) const {
+        auto it = std::ranges::upper_bound(m_dirty, address, {}, &dirty_region::base);
+        if (it == m_dirty.begin())
+            return nullptr;
+
+        const auto& region = *std::prev(it);
+        if (address >= region.base + region.size)
+            return nullptr;
+        return &region.stamps[(address - region.base) / page_size];
+    }
+
+    void process::reset_dirty() {
+        // the generation keeps counting, so one handed out for another process never matches this one
+        std::unique_lock lock(m_dirty_mutex);
+        m_dirty.clear();
+    }
 } // namespace core
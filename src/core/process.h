@@ -4,6 +4,7 @@
 #include <expected>
 #include <filesystem>
 #include <memory>
+#include <shared_mutex>
 #include <span>
 #include <string>
 #include <vector>
@@ -27,12 +28,23 @@ namespace core {
 
         [[nodiscard]] std::expected<void, error_code>
         read_memory(std::uintptr_t address, std::span<std::byte> buffer) override;
+        std::size_t
+        read_memory_batch(std::span<const read_request> requests, std::span<std::uint8_t> readable = {}) override;
+        [[nodiscard]] std::size_t batch_calls(std::size_t requests) const override;
+        [[nodiscard]] std::size_t read_prefix(std::uintptr_t address, std::span<std::byte> buffer) override;
         [[nodiscard]] std::expected<void, error_code>
         write_memory(std::uintptr_t address, std::span<const std::byte> buffer) override;
+        [[nodiscard]] std::size_t write_memory_batch(std::span<const write_request> requests) override;
         [[nodiscard]] std::expected<std::vector<memory_region>, error_code> get_memory_regions() override;
+        [[nodiscard]] std::expected<std::shared_ptr<const region_table>, error_code> get_region_table() override;
         [[nodiscard]] bool is_live() const override;
         [[nodiscard]] std::string get_name() const override;
         [[nodiscard]] std::optional<std::uintptr_t> get_entry_point() const override;
+        [[nodiscard]] std::optional<std::uint32_t> sync_dirty() override;
+        [[nodiscard]] bool
+        written_since(std::uintptr_t address, std::size_t size, std::uint32_t generation) const override;
+        [[nodiscard]] std::expected<void, error_code>
+        resident_pages(std::uintptr_t address, std::size_t size, std::span<std::uint64_t> bits) override;
 
         [[nodiscard]] std::expected<std::vector<process_info>, error_code> enumerate_processes();
         [[nodiscard]] std::expected<void, error_code> attach_to(std::uint32_t pid);
@@ -41,8 +53,23 @@ namespace core {
         [[nodiscard]] std::uint32_t get_attached_pid() const;
 
     private:
+        // generation each page was last seen written in, by readable region sorted by base. the soft dirty bits
+        // are shared by everything scanning the process, so each sync folds them in here before clearing them
+        struct dirty_region {
+            std::uintptr_t base;
+            std::size_t size;
+            std::vector<std::uint32_t> stamps;
+        };
+
+        [[nodiscard]] const std::uint32_t* find_stamp(std::uintptr_t address) const;
+        void reset_dirty();
+
         std::unique_ptr<platform::process_controller> m_controller;
         std::uint32_t m_attached_pid = 0;
         std::string m_attached_process_name;
+
+        std::vector<dirty_region> m_dirty;
+        std::uint32_t m_generation = 0;
+        mutable std::shared_mutex m_dirty_mutex;
     };
 } // namespace core
@@ -0,0 +1,68 @@
+#include <core/region_table.h>
+
+#include <utility>
+
+namespace core {
+    void region_table::builder::reserve(std::size_t regions) {
+        m_entries.reserve(regions);
+    }
+
+    void region_table::builder::add(
+            std::uintptr_t base_address, std::size_t size, std::uint8_t perms, std::string_view name
+    ) {
+        auto it = m_interned.find(name);
+        if (it == m_interned.end()) {
+            it = m_interned.emplace(std::string(name), static_cast<std::uint32_t>(m_names.size())).first;
+            m_names.append(name);
+        }
+        m_entries.push_back({base_address, size, it->second, static_cast<std::uint32_t>(name.size()), perms});
+    }
+
+    std::shared_ptr<const region_table> region_table::builder::finish() {
+        auto table = std::make_shared<region_table>();
+        table->m_entries = std::move(m_entries);
+        table->m_names = std::move(m_names);
+        m_interned.clear();
+        return table;
+    }
+
+    std::shared_ptr<const region_table> region_table::from_regions(std::span<const memory_region> regions) {
+        builder b;
+        b.reserve(regions.size());
+        for (const auto& r : regions) {
+            std::uint8_t perms = 0;
+            if (r.permission.find('r') != std::string::npos)
+                perms |= perm::read;
+            if (r.permission.find('w') != std::string::npos)
+                perms |= perm::write;
+            if (r.permission.find('x') != std::string::npos)
+                perms |= perm::exec;
+            if (r.permission.find('s') != std::string::npos)
+                perms |= perm::shared;
+            b.add(r.base_address, r.size, perms, r.name);
+        }
+        return b.finish();
+    }
+
+    memory_region region_table::region(const region_entry& entry) const {
+        std::string permission = "---p";
+        if (entry.has(perm::read))
+            permission[0] = 'r';
+        if (entry.has(perm::write))
+            permission[1] = 'w';
+        if (entry.has(perm::exec))
+            permission[2] = 'x';
+        if (entry.has(perm::shared))
+            permission[3] = 's';
+        return {entry.base_address, entry.size, std::move(permission), std::string(name(entry))};
+    }
+
+    std::vector<memory_region> region_table::regions() const {
+        std::vector<memory_region> out;
+        out.reserve(m_entries.size());
+        for (const auto& e : m_entries) {
+            out.push_back(region(e));
+        }
+        return out;
+    }
+} // namespace core
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+    struct memory_region {
+        std::uintptr_t base_address;
+        std::size_t size;
+        std::string permission;
+        std::string name;
+
+        auto operator<=>(const memory_region&) const = default;
+    };
+
+    // the controllers name memory they know no file for "<anonymous>", or in brackets after what it is, like linux's
+    // [heap] and [stack] or windows' [private] and [image]. anything else is the path of the mapped file
+    inline bool is_file_backed(const memory_region& r) {
+        return !r.name.empty() && r.name.front() != '[' && r.name.front() != '<';
+    }
+
+    // memory nothing names beyond its kind, which only its size tells apart from others like it
+    inline bool is_anonymous(const memory_region& r) {
+        return r.name.empty() || r.name == "<anonymous>" || r.name == "[private]";
+    }
+
+    // permission bits of a region_entry
+    namespace perm {
+        inline constexpr std::uint8_t read = 1 << 0;
+        inline constexpr std::uint8_t write = 1 << 1;
+        inline constexpr std::uint8_t exec = 1 << 2;
+        inline constexpr std::uint8_t shared = 1 << 3;
+    } // namespace perm
+
+    struct region_entry {
+        std::uintptr_t base_address;
+        std::size_t size;
+        std::uint32_t name_offset; // into the table's name pool
+        std::uint32_t name_size;
+        std::uint8_t perms;
+
+        [[nodiscard]] bool has(std::uint8_t bits) const {
+            return (perms & bits) == bits;
+        }
+    };
+
+    // the regions of a target at one point in time, fixed once built. names are kept once each in a shared pool
+    // and permissions as bits, so a table is a few flat allocations however many regions it holds. tables are
+    // handed out as shared_ptr and one that hasn't changed is handed out again rather than rebuilt
+    class region_table {
+    public:
+        class builder {
+        public:
+            void reserve(std::size_t regions);
+            void add(std::uintptr_t base_address, std::size_t size, std::uint8_t perms, std::string_view name);
+            [[nodiscard]] std::shared_ptr<const region_table> finish();
+
+        private:
+            struct name_hash {
+                using is_transparent = void;
+                std::size_t operator()(std::string_view name) const {
+                    return std::hash<std::string_view>{}(name);
+                }
+            };
+
+            std::vector<region_entry> m_entries;
+            std::string m_names;
+            // offset of every name already in m_names, there are far fewer names than regions
+            std::unordered_map<std::string, std::uint32_t, name_hash, std::equal_to<>> m_interned;
+        };
+
+        // from the regions as a target lists them, permissions read from the usual "rwxp" letters
+        static std::shared_ptr<const region_table> from_regions(std::span<const memory_region> regions);
+
+        [[nodiscard]] std::span<const region_entry> entries() const {
+            return m_entries;
+        }
+        [[nodiscard]] std::size_t size() const {
+            return m_entries.size();
+        }
+        [[nodiscard]] std::string_view name(const region_entry& entry) const {
+            return std::string_view(m_names).substr(entry.name_offset, entry.name_size);
+        }
+
+        // the entry spelled out as a memory_region, permission as "rwxp" with '-' for missing bits
+        [[nodiscard]] memory_region region(const region_entry& entry) const;
+        [[nodiscard]] std::vector<memory_region> regions() const;
+
+    private:
+        std::vector<region_entry> m_entries;
+        std::string m_names;
+    };
+} // namespace core
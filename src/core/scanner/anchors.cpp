@@ -0,0 +1,43 @@
+#include <core/scanner/anchors.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <utility>
+
+namespace core {
+    std::vector<anchor> find_anchors(std::vector<memory_region> regions) {
+        std::ranges::sort(regions, {}, &memory_region::base_address);
+
+        std::vector<anchor> anchors;
+        std::map<std::pair<std::string, std::uint64_t>, std::uint64_t> seen;
+        std::optional<std::string> module;
+        std::uintptr_t previous_end = 0;
+
+        for (const auto& r : regions) {
+            if (is_file_backed(r)) {
+                module = std::filesystem::path(r.name).filename().string();
+            } else if (!module || r.base_address != previous_end || r.name == "[heap]") {
+                module.reset();
+            }
+
+            // named regions keep their name while they grow, anonymous ones come and go between runs and are
+            // only matched up with one of the same size
+            auto name = module.value_or(r.name);
+            const std::uint64_t extent = !module && is_anonymous(r) ? r.size : 0;
+            const std::uint64_t ordinal = seen[std::pair(name, extent)]++;
+            anchors.push_back({{std::move(name), extent, ordinal}, r.base_address, r.size});
+            previous_end = r.base_address + r.size;
+        }
+        return anchors;
+    }
+
+    const anchor* owning_anchor(std::span<const anchor> anchors, std::uintptr_t address) {
+        auto it = std::ranges::upper_bound(anchors, address, {}, &anchor::base);
+        if (it == anchors.begin() || address - std::prev(it)->base >= std::prev(it)->size)
+            return nullptr;
+        return &*std::prev(it);
+    }
+} // namespace core
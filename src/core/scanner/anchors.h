@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "core/target.h"
+
+namespace core {
+    // what a region is known by across runs and across instances of the same binary, and how many regions known
+    // by the same come before it
+    struct anchor_key {
+        std::string name;
+        std::uint64_t extent = 0; // size of anonymous regions, which is all that tells those apart
+        std::uint64_t ordinal = 0;
+
+        auto operator<=>(const anchor_key&) const = default;
+    };
+
+    struct anchor {
+        anchor_key key;
+        std::uintptr_t base = 0;
+        std::size_t size = 0;
+    };
+
+    // one anchor per region, sorted by base. an anonymous region starting right where an image ends is taken as
+    // that image's bss, the same way the pointer scanner does, so it keeps its name when the heap in front of it
+    // changes
+    std::vector<anchor> find_anchors(std::vector<memory_region> regions);
+
+    // the anchor whose region holds address, if any
+    const anchor* owning_anchor(std::span<const anchor> anchors, std::uintptr_t address);
+} // namespace core
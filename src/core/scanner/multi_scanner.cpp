@@ -0,0 +1,259 @@
+#include <core/scanner/multi_scanner.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <span>
+#include <utility>
+#include "core/scanner/anchors.h"
+
+namespace core {
+    namespace {
+        constexpr std::size_t read_window = 64 * 1024;
+
+        // where a result sits in terms every instance agrees on, regions numbered by key across instances
+        struct location {
+            std::uint32_t region = 0;
+            std::uint64_t offset = 0;
+            std::uint8_t tag = 0;
+
+            auto operator<=>(const location&) const = default;
+        };
+
+        constexpr std::uint32_t no_region = UINT32_MAX;
+    } // namespace
+
+    multi_scanner::multi_scanner() = default;
+
+    multi_scanner::~multi_scanner() {
+        cancel();
+    }
+
+    std::expected<void, error_code> multi_scanner::add(std::uint32_t pid) {
+        if (busy)
+            return std::unexpected(error_code::not_supported);
+        if (std::ranges::find(instances, pid, &instance::pid) != instances.end())
+            return {};
+
+        auto p = std::make_unique<process>();
+        if (auto attached = p->attach_to(pid); !attached)
+            return std::unexpected(attached.error());
+
+        instance inst;
+        inst.pid = pid;
+        inst.name = p->get_name();
+        inst.engine = std::make_unique<scanner>(p.get());
+        inst.target = std::move(p);
+        instances.push_back(std::move(inst));
+        return {};
+    }
+
+    void multi_scanner::remove(std::uint32_t pid) {
+        if (busy)
+            return;
+        // the scanner goes first, it holds on to the process
+        std::erase_if(instances, [&](const instance& inst) { return inst.pid == pid; });
+    }
+
+    void multi_scanner::clear() {
+        cancel();
+        instances.clear();
+    }
+
+    void multi_scanner::begin_first_scan(const scan_config& config) {
+        cancel();
+        run(config, true);
+    }
+
+    void multi_scanner::begin_next_scan(const scan_config& config) {
+        cancel();
+        run(config, false);
+    }
+
+    void multi_scanner::begin_intersect() {
+        cancel();
+        run(std::nullopt, false);
+    }
+
+    void multi_scanner::run(std::optional<scan_config> config, bool first) {
+        if (instances.empty())
+            return;
+
+        busy = true;
+        cancel_req = false;
+
+        // each scanner runs on its own thread and hands its regions to the pool, so the instances share the
+        // workers and none of them waits for another to finish
+        if (config) {
+            for (auto& inst : instances) {
+                if (first) {
+                    inst.engine->begin_first_scan(*config);
+                } else {
+                    inst.engine->begin_next_scan(*config);
+                }
+            }
+        }
+
+        worker = std::jthread([this, intersect_only = !config] {
+            for (auto& inst : instances) {
+                inst.engine->wait();
+            }
+            if (!cancel_req && (intersect_only || intersect_results)) {
+                intersect();
+            }
+            busy = false;
+        });
+    }
+
+    void multi_scanner::cancel() {
+        cancel_req = true;
+        for (auto& inst : instances) {
+            inst.engine->cancel();
+        }
+        if (worker.joinable())
+            worker.join();
+        busy = false;
+    }
+
+    void multi_scanner::reset() {
+        cancel();
+        for (auto& inst : instances) {
+            inst.engine->reset();
+        }
+    }
+
+    void multi_scanner::set_intersect(bool enabled) {
+        intersect_results = enabled;
+    }
+
+    bool multi_scanner::intersects() const {
+        return intersect_results;
+    }
+
+    bool multi_scanner::is_scanning() const {
+        return busy;
+    }
+
+    float multi_scanner::progress() const {
+        if (instances.empty())
+            return 0.0f;
+
+        float slowest = 1.0f;
+        for (const auto& inst : instances) {
+            slowest = std::min(slowest, inst.engine->is_scanning() ? inst.engine->progress() : 1.0f);
+        }
+        return slowest;
+    }
+
+    std::size_t multi_scanner::instance_count() const {
+        return instances.size();
+    }
+
+    std::vector<instance_hits> multi_scanner::hit_counts() const {
+        std::vector<instance_hits> counts;
+        counts.reserve(instances.size());
+        for (const auto& inst : instances) {
+            const auto& engine = *inst.engine;
+            counts.push_back(
+                    {inst.pid, inst.name, engine.is_scanning() ? engine.get_stream().found() : engine.result_count()}
+            );
+        }
+        return counts;
+    }
+
+    std::uint32_t multi_scanner::pid(std::size_t index) const {
+        return instances[index].pid;
+    }
+
+    process& multi_scanner::process_of(std::size_t index) {
+        return *instances[index].target;
+    }
+
+    scanner& multi_scanner::engine(std::size_t index) {
+        return *instances[index].engine;
+    }
+
+    const scanner& multi_scanner::engine(std::size_t index) const {
+        return *instances[index].engine;
+    }
+
+    void multi_scanner::intersect() {
+        if (instances.size() < 2)
+            return;
+
+        // every result of every instance located by region key and offset, and the locations all of them share
+        std::map<anchor_key, std::uint32_t> region_ids;
+        std::vector<std::vector<location>> located(instances.size());
+        std::vector<location> common;
+        std::vector<location> sorted;
+        std::vector<std::uintptr_t> window(read_window);
+
+        for (std::size_t i = 0; i < instances.size(); ++i) {
+            auto& inst = instances[i];
+
+            // instances whose regions can't be listed share nothing with the others
+            std::vector<anchor> anchors;
+            if (auto regions = inst.target->get_memory_regions()) {
+                anchors = find_anchors(std::move(*regions));
+            }
+            std::vector<std::uint32_t> ids(anchors.size());
+            for (std::size_t a = 0; a < anchors.size(); ++a) {
+                ids[a] = region_ids.emplace(anchors[a].key, static_cast<std::uint32_t>(region_ids.size()))
+                                 .first->second;
+            }
+
+            {
+                auto lock = inst.engine->lock_results();
+                // snapshot candidates aren't listed, there is nothing to line up until a next scan lists them
+                if (inst.engine->has_snapshot())
+                    return;
+
+                const auto& results = inst.engine->get_results();
+                auto& out = located[i];
+                out.reserve(results.size());
+                for (const auto& seg : results.segments()) {
+                    for (std::size_t done = 0; done < seg.count;) {
+                        const std::size_t want = std::min<std::size_t>(read_window, seg.count - done);
+                        const std::size_t count =
+                                results.read(seg.first_index + done, std::span(window).first(want));
+                        if (count == 0)
+                            break;
+                        done += count;
+
+                        for (std::size_t k = 0; k < count; ++k) {
+                            const anchor* at = owning_anchor(anchors, window[k]);
+                            if (!at) {
+                                out.push_back({no_region, window[k], seg.tag});
+                            } else {
+                                const auto region = ids[static_cast<std::size_t>(at - anchors.data())];
+                                out.push_back({region, window[k] - at->base, seg.tag});
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (cancel_req)
+                return;
+
+            sorted = located[i];
+            std::ranges::sort(sorted);
+            if (i == 0) {
+                common = std::move(sorted);
+            } else {
+                std::vector<location> both;
+                std::ranges::set_intersection(common, sorted, std::back_inserter(both));
+                common = std::move(both);
+            }
+        }
+
+        std::vector<std::uint8_t> keep;
+        for (std::size_t i = 0; i < instances.size(); ++i) {
+            keep.resize(located[i].size());
+            for (std::size_t k = 0; k < keep.size(); ++k) {
+                keep[k] = located[i][k].region != no_region && std::ranges::binary_search(common, located[i][k]);
+            }
+            instances[i].engine->keep_results(keep);
+        }
+    }
+} // namespace core
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/process.h"
+#include "core/scanner/scanner.h"
+
+namespace core {
+    struct instance_hits {
+        std::uint32_t pid = 0;
+        std::string name;
+        std::size_t hits = 0;
+    };
+
+    // the same scans over several processes at once, meant for instances of one binary. every instance has a
+    // process and a scanner of its own, their scans run side by side on the shared thread pool
+    class multi_scanner {
+    public:
+        multi_scanner();
+        ~multi_scanner();
+
+        multi_scanner(const multi_scanner&) = delete;
+        multi_scanner& operator=(const multi_scanner&) = delete;
+        multi_scanner(multi_scanner&&) = delete;
+        multi_scanner& operator=(multi_scanner&&) = delete;
+
+        // attaches to pid as one more instance. instances can't be added or removed while a scan runs
+        std::expected<void, error_code> add(std::uint32_t pid);
+        void remove(std::uint32_t pid);
+        void clear();
+
+        void begin_first_scan(const scan_config& config);
+        void begin_next_scan(const scan_config& config);
+        // runs the intersection on its own, see set_intersect
+        void begin_intersect();
+
+        void cancel();
+        void reset();
+
+        // after every scan, keeps only the results at a region relative offset, see find_anchors, that every
+        // instance has a result of the same type at. instances of one binary lay their images out the same way, so
+        // a value they all hold usually sits at the same offset, where unrelated hits rarely line up
+        void set_intersect(bool enabled);
+        [[nodiscard]] bool intersects() const;
+
+        [[nodiscard]] bool is_scanning() const;
+        // of the instance furthest behind
+        [[nodiscard]] float progress() const;
+
+        [[nodiscard]] std::size_t instance_count() const;
+        // results per instance, counted as they come in while a scan runs
+        [[nodiscard]] std::vector<instance_hits> hit_counts() const;
+
+        [[nodiscard]] std::uint32_t pid(std::size_t index) const;
+        [[nodiscard]] process& process_of(std::size_t index);
+        [[nodiscard]] scanner& engine(std::size_t index);
+        [[nodiscard]] const scanner& engine(std::size_t index) const;
+
+    private:
+        struct instance {
+            std::uint32_t pid = 0;
+            std::string name;
+            std::unique_ptr<process> target;
+            std::unique_ptr<scanner> engine;
+        };
+
+        void run(std::optional<scan_config> config, bool first);
+        void intersect();
+
+        std::vector<instance> instances;
+
+        std::atomic<bool> intersect_results = false;
+        std::atomic<bool> busy = false;
+        std::atomic<bool> cancel_req = false;
+
+        std::jthread worker;
+    };
+} // namespace core
@@ -0,0 +1,170 @@
+#include <core/scanner/pattern.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace core {
+    namespace {
+        constexpr std::byte fixed{0xFF};
+
+        std::optional<unsigned> hex_digit(char c) {
+            if (c >= '0' && c <= '9')
+                return static_cast<unsigned>(c - '0');
+            if (c >= 'a' && c <= 'f')
+                return static_cast<unsigned>(c - 'a' + 10);
+            if (c >= 'A' && c <= 'F')
+                return static_cast<unsigned>(c - 'A' + 10);
+            return std::nullopt;
+        }
+
+        bool is_space(char c) {
+            return std::isspace(static_cast<unsigned char>(c)) != 0;
+        }
+    } // namespace
+
+    std::optional<byte_pattern> byte_pattern::parse(std::string_view text) {
+        std::vector<std::byte> bytes;
+        std::vector<std::byte> mask;
+
+        std::size_t at = 0;
+        while (at < text.size()) {
+            if (is_space(text[at])) {
+                ++at;
+                continue;
+            }
+
+            std::size_t end = at;
+            while (end < text.size() && !is_space(text[end])) {
+                ++end;
+            }
+            const auto token = text.substr(at, end - at);
+            at = end;
+
+            if (token == "?") {
+                bytes.push_back(std::byte{0});
+                mask.push_back(std::byte{0});
+                continue;
+            }
+
+            // tokens longer than a byte are runs of bytes written without spaces
+            if (token.size() % 2 != 0)
+                return std::nullopt;
+
+            for (std::size_t i = 0; i < token.size(); i += 2) {
+                unsigned value = 0;
+                unsigned bits = 0;
+                for (const char c : token.substr(i, 2)) {
+                    value <<= 4;
+                    bits <<= 4;
+                    if (c == '?')
+                        continue;
+
+                    const auto digit = hex_digit(c);
+                    if (!digit)
+                        return std::nullopt;
+                    value |= *digit;
+                    bits |= 0xF;
+                }
+                bytes.push_back(static_cast<std::byte>(value));
+                mask.push_back(static_cast<std::byte>(bits));
+            }
+        }
+
+        if (std::ranges::find(mask, fixed) == mask.end())
+            return std::nullopt;
+
+        return byte_pattern(std::move(bytes), std::move(mask));
+    }
+
+    byte_pattern::byte_pattern(std::vector<std::byte> bytes, std::vector<std::byte> mask) :
+        m_bytes(std::move(bytes)), m_mask(std::move(mask)) {
+        // the outermost fixed bytes make the prefilter pair, the further apart they are the less they correlate
+        std::size_t first = 0;
+        while (m_mask[first] != fixed) {
+            ++first;
+        }
+        std::size_t last = size() - 1;
+        while (m_mask[last] != fixed) {
+            --last;
+        }
+        m_pair = {
+                .first = static_cast<std::uint8_t>(m_bytes[first]),
+                .last = static_cast<std::uint8_t>(m_bytes[last]),
+                .first_at = first,
+                .last_at = last
+        };
+
+        // a wildcard matches whatever byte ends the window, so no shift may carry it past one. the byte under the
+        // last position never takes part, the window is moved by the byte that ends it
+        std::size_t limit = size();
+        for (std::size_t i = 0; i + 1 < size(); ++i) {
+            if (m_mask[i] != fixed) {
+                limit = size() - 1 - i;
+            }
+        }
+
+        m_shift.fill(static_cast<std::uint32_t>(limit));
+        for (std::size_t i = size() - limit; i + 1 < size(); ++i) {
+            m_shift[static_cast<std::uint8_t>(m_bytes[i])] = static_cast<std::uint32_t>(size() - 1 - i);
+        }
+    }
+
+    bool byte_pattern::has_wildcards() const {
+        return std::ranges::any_of(m_mask, [](std::byte b) {
+            return b != fixed;
+        });
+    }
+
+    bool byte_pattern::matches(const std::byte* data) const {
+        // eight bytes at a time, wildcard bits are clear in both the mask and the pattern
+        std::size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= size(); i += sizeof(std::uint64_t)) {
+            std::uint64_t value, mask, pattern;
+            std::memcpy(&value, data + i, sizeof(value));
+            std::memcpy(&mask, m_mask.data() + i, sizeof(mask));
+            std::memcpy(&pattern, m_bytes.data() + i, sizeof(pattern));
+            if ((value & mask) != pattern)
+                return false;
+        }
+
+        for (; i < size(); ++i) {
+            if ((data[i] & m_mask[i]) != m_bytes[i])
+                return false;
+        }
+        return true;
+    }
+
+    std::size_t byte_pattern::find(std::span<const std::byte> data, std::uint32_t* out, simd::level level) const {
+        if (data.size() < size())
+            return 0;
+
+        // the skip table is only the fallback without vector units. in bench/pattern_find the pair prefilter stays
+        // ahead of it until patterns get to about 128 bytes, where horspool draws level with sse2
+        if (level == simd::level::scalar)
+            return find_horspool(data, out);
+
+        // cut so that every offset the pair kernel tries still has room for the whole pattern
+        const auto candidates = data.first(data.size() - size() + m_pair.last_at + 1);
+        const std::size_t found = simd::select_pair(level)(candidates, m_pair, out);
+
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < found; ++i) {
+            if (matches(data.data() + out[i])) {
+                out[count++] = out[i];
+            }
+        }
+        return count;
+    }
+
+    std::size_t byte_pattern::find_horspool(std::span<const std::byte> data, std::uint32_t* out) const {
+        std::size_t count = 0;
+        for (std::size_t at = 0; at + size() <= data.size();
+             at += m_shift[static_cast<std::uint8_t>(data[at + size() - 1])]) {
+            if (matches(data.data() + at)) {
+                out[count++] = static_cast<std::uint32_t>(at);
+            }
+        }
+        return count;
+    }
+} // namespace core
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "core/scanner/simd.h"
+
+namespace core {
+    // byte signature with wildcards, written as hex bytes like "48 8B 05 ?? ?? ?? ?? 48 85 C0". ? or ?? stands for
+    // any byte and a ? in place of one hex digit for any value of that nibble
+    class byte_pattern {
+    public:
+        // nullopt for malformed text and for patterns without a single fixed byte
+        static std::optional<byte_pattern> parse(std::string_view text);
+
+        [[nodiscard]] std::size_t size() const {
+            return m_bytes.size();
+        }
+
+        // the pattern with every wildcard bit cleared
+        [[nodiscard]] std::span<const std::byte> bytes() const {
+            return m_bytes;
+        }
+
+        [[nodiscard]] bool has_wildcards() const;
+
+        // data has to hold at least size() bytes
+        [[nodiscard]] bool matches(const std::byte* data) const;
+
+        // writes the offset of every match that fits inside data, in ascending order. out must have room for
+        // data.size() + 1 entries. the vector levels prefilter on two fixed bytes, scalar uses a horspool skip
+        // that only stands in for them where there are no vector units
+        std::size_t
+        find(std::span<const std::byte> data, std::uint32_t* out, simd::level level = simd::supported_level()) const;
+
+    private:
+        byte_pattern(std::vector<std::byte> bytes, std::vector<std::byte> mask);
+
+        std::size_t find_horspool(std::span<const std::byte> data, std::uint32_t* out) const;
+
+        std::vector<std::byte> m_bytes;
+        std::vector<std::byte> m_mask;
+        simd::byte_pair m_pair;
+        std::array<std::uint32_t, 256> m_shift{};
+    };
+} // namespace core
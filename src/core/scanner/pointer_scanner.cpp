@@ -0,0 +1,536 @@
+#include <core/scanner/pointer_scanner.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include "util/thread_pool.h"
+#include "util/varint.h"
+
+namespace core {
+    namespace {
+        constexpr std::size_t chunk_size = 1024 * 1024;
+        constexpr std::size_t task_size = 16 * chunk_size;
+
+        constexpr std::array<char, 4> file_magic = {'R', 'V', 'P', 'C'};
+        constexpr std::uint8_t file_version = 1;
+        constexpr std::uint64_t max_file_depth = 64;
+
+        // a value in memory that points into a readable region, and where it was found
+        struct pointer_entry {
+            std::uint64_t value;
+            std::uint64_t location;
+        };
+
+        struct address_range {
+            std::uintptr_t base;
+            std::uintptr_t end;
+        };
+
+        struct module_range {
+            std::uintptr_t base;
+            std::uintptr_t end;
+            std::uint32_t module;
+        };
+
+        // module images by file name, with the ranges each one owns sorted by address
+        struct module_table {
+            std::vector<std::string> names;
+            std::vector<std::uintptr_t> bases;
+            std::vector<module_range> ranges;
+
+            [[nodiscard]] std::optional<std::uint32_t> owner(std::uintptr_t address) const {
+                auto it = std::ranges::upper_bound(ranges, address, {}, &module_range::base);
+                if (it == ranges.begin() || address >= std::prev(it)->end)
+                    return std::nullopt;
+                return std::prev(it)->module;
+            }
+        };
+
+        struct scan_task {
+            std::uintptr_t base;
+            std::size_t size;
+        };
+
+        std::uint64_t read_pointer(const std::byte* at, std::size_t pointer_size) {
+            if (pointer_size == sizeof(std::uint32_t)) {
+                std::uint32_t value;
+                std::memcpy(&value, at, sizeof(value));
+                return value;
+            }
+            std::uint64_t value;
+            std::memcpy(&value, at, sizeof(value));
+            return value;
+        }
+
+        bool is_readable(const memory_region& r) {
+            return r.permission.find('r') != std::string::npos;
+        }
+
+        // sorted with touching ranges merged, so a lookup is one binary search
+        std::vector<address_range> readable_ranges(const std::vector<memory_region>& regions) {
+            std::vector<address_range> ranges;
+            for (const auto& r : regions) {
+                if (is_readable(r) && r.size > 0) {
+                    ranges.push_back({r.base_address, r.base_address + r.size});
+                }
+            }
+            std::ranges::sort(ranges, {}, &address_range::base);
+
+            std::vector<address_range> merged;
+            for (const auto& r : ranges) {
+                if (!merged.empty() && r.base <= merged.back().end) {
+                    merged.back().end = std::max(merged.back().end, r.end);
+                } else {
+                    merged.push_back(r);
+                }
+            }
+            return merged;
+        }
+
+        bool contains(std::span<const address_range> ranges, std::uint64_t address) {
+            auto it = std::ranges::upper_bound(ranges, address, {}, &address_range::base);
+            return it != ranges.begin() && address < std::prev(it)->end;
+        }
+
+        // an anonymous region starting right where an image ends is taken as that image's bss, which is where
+        // most static pointers live
+        module_table find_modules(std::vector<memory_region> regions) {
+            std::ranges::sort(regions, {}, &memory_region::base_address);
+
+            module_table table;
+            std::optional<std::uint32_t> previous;
+            std::uintptr_t previous_end = 0;
+
+            for (const auto& r : regions) {
+                const std::uintptr_t end = r.base_address + r.size;
+                std::optional<std::uint32_t> module;
+
+                if (is_file_backed(r)) {
+                    const auto name = std::filesystem::path(r.name).filename().string();
+                    auto it = std::ranges::find(table.names, name);
+                    if (it == table.names.end()) {
+                        table.names.push_back(name);
+                        table.bases.push_back(r.base_address);
+                        it = std::prev(table.names.end());
+                    }
+                    module = static_cast<std::uint32_t>(it - table.names.begin());
+                } else if (previous && r.base_address == previous_end && r.name != "[heap]") {
+                    module = previous;
+                }
+
+                if (module) {
+                    table.ranges.push_back({r.base_address, end, *module});
+                    table.bases[*module] = std::min(table.bases[*module], r.base_address);
+                }
+                previous = module;
+                previous_end = end;
+            }
+            return table;
+        }
+
+        // every task sorts its own entries, then rounds of pairwise merges on the pool leave one sorted list
+        std::vector<pointer_entry> merge_shards(std::vector<std::vector<pointer_entry>> shards, thread_pool& pool) {
+            while (shards.size() > 1) {
+                std::vector<std::vector<pointer_entry>> merged((shards.size() + 1) / 2);
+                pool.parallel_for(merged.size(), [&](std::size_t i, std::size_t) {
+                    auto& a = shards[2 * i];
+                    if (2 * i + 1 == shards.size()) {
+                        merged[i] = std::move(a);
+                        return;
+                    }
+
+                    auto& b = shards[2 * i + 1];
+                    merged[i].resize(a.size() + b.size());
+                    std::ranges::merge(a, b, merged[i].begin(), {}, &pointer_entry::value, &pointer_entry::value);
+                    a = {};
+                    b = {};
+                });
+                shards = std::move(merged);
+            }
+
+            if (shards.empty())
+                return {};
+            return std::move(shards.front());
+        }
+    } // namespace
+
+    pointer_scanner::pointer_scanner(target* t) : active_target(t) {
+    }
+
+    pointer_scanner::~pointer_scanner() {
+        cancel();
+    }
+
+    void pointer_scanner::set_target(target* t) {
+        cancel();
+        std::lock_guard lock(results_mutex);
+        results = {};
+        active_target = t;
+    }
+
+    std::unique_lock<std::mutex> pointer_scanner::lock_results() const {
+        return std::unique_lock(results_mutex);
+    }
+
+    void pointer_scanner::begin_scan(const pointer_scan_config& config) {
+        if (config.pointer_size != sizeof(std::uint32_t) && config.pointer_size != sizeof(std::uint64_t))
+            return;
+
+        cancel();
+        scanning = true;
+        cancel_req = false;
+        progress_val = 0.0f;
+
+        scan_thread = std::jthread([this, config] {
+            worker_scan(config);
+        });
+    }
+
+    void pointer_scanner::cancel() {
+        if (scanning) {
+            cancel_req = true;
+            if (scan_thread.joinable())
+                scan_thread.join();
+        }
+    }
+
+    float pointer_scanner::progress() const {
+        return progress_val;
+    }
+
+    bool pointer_scanner::is_scanning() const {
+        return scanning;
+    }
+
+    const pointer_chains& pointer_scanner::get_results() const {
+        return results;
+    }
+
+    void pointer_scanner::worker_scan(pointer_scan_config config) {
+        auto regions = active_target ? active_target->get_memory_regions()
+                                     : std::expected<std::vector<memory_region>, error_code>{};
+        if (!active_target || !regions) {
+            scanning = false;
+            return;
+        }
+
+        const auto modules = find_modules(*regions);
+        const auto ranges = readable_ranges(*regions);
+        if (ranges.empty()) {
+            scanning = false;
+            return;
+        }
+        const std::uint64_t lowest = ranges.front().base;
+        const std::uint64_t highest = ranges.back().end;
+
+        std::vector<scan_task> tasks;
+        std::size_t total = 0;
+        for (const auto& r : *regions) {
+            if (!is_readable(r))
+                continue;
+            for (std::size_t offset = 0; offset < r.size; offset += task_size) {
+                tasks.push_back({r.base_address + offset, std::min(task_size, r.size - offset)});
+            }
+            total += r.size;
+        }
+
+        // the map takes most of the time, the walk gets the last fifth of the progress bar
+        constexpr float map_share = 0.8f;
+        const std::size_t step = config.aligned ? config.pointer_size : 1;
+
+        auto& pool = thread_pool::shared();
+        std::vector<std::vector<std::byte>> buffers(pool.size());
+        std::vector<std::vector<pointer_entry>> shards(tasks.size());
+        std::atomic<std::size_t> mapped = 0;
+
+        pool.parallel_for(tasks.size(), [&](std::size_t task_idx, std::size_t worker) {
+            auto& buffer = buffers[worker];
+            if (buffer.empty()) {
+                buffer.resize(chunk_size);
+            }
+
+            const auto& task = tasks[task_idx];
+            auto& shard = shards[task_idx];
+
+            for (std::size_t offset = 0; offset < task.size && !cancel_req; offset += chunk_size) {
+                const std::uintptr_t current = task.base + offset;
+                const std::size_t size = std::min(chunk_size, task.size - offset);
+                std::span<std::byte> view(buffer.data(), size);
+
+                if (active_target->read_memory(current, view)) {
+                    for (std::size_t at = 0; at + config.pointer_size <= size; at += step) {
+                        const std::uint64_t value = read_pointer(view.data() + at, config.pointer_size);
+                        // most words are zero or small integers, the bounds drop them before the search
+                        if (value >= lowest && value < highest && contains(ranges, value)) {
+                            shard.push_back({value, current + at});
+                        }
+                    }
+                }
+
+                const std::size_t done = mapped.fetch_add(size) + size;
+                progress_val = map_share * static_cast<float>(done) / static_cast<float>(total);
+            }
+
+            std::ranges::sort(shard, {}, &pointer_entry::value);
+        });
+
+        if (cancel_req) {
+            scanning = false;
+            return;
+        }
+
+        const auto map = merge_shards(std::move(shards), pool);
+
+        // every location is kept at the depth it is first reached at, with edges only to the depth before. so
+        // each chain listed is as short as it can be and the graph has no cycles. node 0 is the address itself
+        struct node {
+            std::uintptr_t address;
+            std::uint32_t depth;
+        };
+        struct edge {
+            std::uint32_t from;
+            std::uint32_t to;
+            std::uint32_t offset;
+        };
+        struct candidate {
+            std::uintptr_t location;
+            std::uint32_t to;
+            std::uint32_t offset;
+        };
+
+        std::vector<node> nodes{{config.address, 0}};
+        std::vector<edge> edges;
+        std::vector<std::uint32_t> roots;
+        std::unordered_map<std::uintptr_t, std::uint32_t> seen{{config.address, 0}};
+        std::vector<std::uint32_t> frontier{0};
+
+        for (std::uint32_t depth = 1; depth <= config.max_depth && !frontier.empty() && !cancel_req; ++depth) {
+            // lookups run on the pool, only adding them to the graph is sequential
+            constexpr std::size_t slice = 1024;
+            std::vector<std::vector<candidate>> found((frontier.size() + slice - 1) / slice);
+
+            pool.parallel_for(found.size(), [&](std::size_t s, std::size_t) {
+                const std::size_t last = std::min(frontier.size(), (s + 1) * slice);
+                for (std::size_t i = s * slice; i < last; ++i) {
+                    const std::uint32_t to = frontier[i];
+                    const std::uint64_t address = nodes[to].address;
+                    const std::uint64_t least = address >= config.max_offset ? address - config.max_offset : 0;
+
+                    auto it = std::ranges::lower_bound(map, least, {}, &pointer_entry::value);
+                    for (; it != map.end() && it->value <= address; ++it) {
+                        found[s].push_back({it->location, to, static_cast<std::uint32_t>(address - it->value)});
+                    }
+                }
+            });
+
+            std::vector<std::uint32_t> next;
+            for (const auto& list : found) {
+                for (const auto& c : list) {
+                    const auto [it, inserted] = seen.try_emplace(c.location, static_cast<std::uint32_t>(nodes.size()));
+                    if (inserted) {
+                        nodes.push_back({c.location, depth});
+                        // a static location ends the chain, nothing needs to point at it
+                        if (modules.owner(c.location)) {
+                            roots.push_back(it->second);
+                        } else {
+                            next.push_back(it->second);
+                        }
+                    } else if (nodes[it->second].depth != depth) {
+                        continue;
+                    }
+                    edges.push_back({it->second, c.to, c.offset});
+                }
+            }
+
+            frontier = std::move(next);
+            progress_val = map_share + (1.0f - map_share) * static_cast<float>(depth) /
+                                               static_cast<float>(config.max_depth);
+        }
+
+        if (cancel_req) {
+            scanning = false;
+            return;
+        }
+
+        std::ranges::sort(edges, {}, &edge::from);
+        std::ranges::sort(roots, {}, [&](std::uint32_t n) {
+            return nodes[n].address;
+        });
+
+        pointer_chains chains;
+        chains.pointer_size = config.pointer_size;
+        chains.modules = modules.names;
+
+        std::vector<std::uint32_t> offsets;
+        auto walk = [&](auto& self, std::uint32_t n, std::uint32_t root) -> void {
+            if (n == 0) {
+                const auto module = *modules.owner(nodes[root].address);
+                chains.chains.push_back({module, nodes[root].address - modules.bases[module], offsets});
+                return;
+            }
+
+            const auto [first, last] = std::ranges::equal_range(edges, n, {}, &edge::from);
+            for (auto it = first; it != last && chains.chains.size() < config.max_chains; ++it) {
+                offsets.push_back(it->offset);
+                self(self, it->to, root);
+                offsets.pop_back();
+            }
+        };
+        for (const auto root : roots) {
+            if (chains.chains.size() >= config.max_chains)
+                break;
+            walk(walk, root, root);
+        }
+
+        {
+            std::lock_guard lock(results_mutex);
+            results = std::move(chains);
+        }
+
+        scanning = false;
+        progress_val = 1.0f;
+    }
+
+    std::vector<std::optional<std::uintptr_t>>
+    pointer_scanner::locate_modules(target& t, const pointer_chains& chains) {
+        std::vector<std::optional<std::uintptr_t>> bases(chains.modules.size());
+
+        auto regions = t.get_memory_regions();
+        if (!regions)
+            return bases;
+
+        const auto modules = find_modules(std::move(*regions));
+        for (std::size_t i = 0; i < chains.modules.size(); ++i) {
+            if (auto it = std::ranges::find(modules.names, chains.modules[i]); it != modules.names.end()) {
+                bases[i] = modules.bases[static_cast<std::size_t>(it - modules.names.begin())];
+            }
+        }
+        return bases;
+    }
+
+    std::optional<std::uintptr_t> pointer_scanner::resolve(
+            target& t, std::span<const std::optional<std::uintptr_t>> bases, std::size_t pointer_size,
+            const pointer_chain& chain
+    ) {
+        if (chain.module >= bases.size() || !bases[chain.module])
+            return std::nullopt;
+
+        std::uintptr_t address = *bases[chain.module] + chain.base_offset;
+        std::array<std::byte, sizeof(std::uint64_t)> buffer{};
+        for (const auto offset : chain.offsets) {
+            if (!t.read_memory(address, std::span(buffer).first(pointer_size)))
+                return std::nullopt;
+            address = read_pointer(buffer.data(), pointer_size) + offset;
+        }
+        return address;
+    }
+
+    pointer_chains pointer_scanner::revalidate(target& t, const pointer_chains& chains, std::uintptr_t address) {
+        const auto bases = locate_modules(t, chains);
+
+        constexpr std::size_t block = 4096;
+        std::vector<std::uint8_t> keep(chains.chains.size());
+        thread_pool::shared().parallel_for((keep.size() + block - 1) / block, [&](std::size_t b, std::size_t) {
+            const std::size_t last = std::min(keep.size(), (b + 1) * block);
+            for (std::size_t i = b * block; i < last; ++i) {
+                keep[i] = resolve(t, bases, chains.pointer_size, chains.chains[i]) == address;
+            }
+        });
+
+        pointer_chains kept;
+        kept.pointer_size = chains.pointer_size;
+        kept.modules = chains.modules;
+        for (std::size_t i = 0; i < keep.size(); ++i) {
+            if (keep[i]) {
+                kept.chains.push_back(chains.chains[i]);
+            }
+        }
+        return kept;
+    }
+
+    std::expected<void, error_code>
+    pointer_scanner::save(const std::filesystem::path& path, const pointer_chains& chains) {
+        // magic, version, pointer size, then the module names and every chain as varints
+        std::vector<std::uint8_t> out(file_magic.begin(), file_magic.end());
+        out.push_back(file_version);
+        out.push_back(static_cast<std::uint8_t>(chains.pointer_size));
+
+        put_varint(out, chains.modules.size());
+        for (const auto& name : chains.modules) {
+            put_varint(out, name.size());
+            out.insert(out.end(), name.begin(), name.end());
+        }
+
+        put_varint(out, chains.chains.size());
+        for (const auto& chain : chains.chains) {
+            put_varint(out, chain.module);
+            put_varint(out, chain.base_offset);
+            put_varint(out, chain.offsets.size());
+            for (const auto offset : chain.offsets) {
+                put_varint(out, offset);
+            }
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size())))
+            return std::unexpected(error_code::write_failed);
+        return {};
+    }
+
+    std::expected<pointer_chains, error_code> pointer_scanner::load(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return std::unexpected(error_code::read_failed);
+
+        const std::vector<std::uint8_t> in(std::istreambuf_iterator<char>(file), {});
+        if (in.size() < file_magic.size() + 2 || !std::equal(file_magic.begin(), file_magic.end(), in.begin()) ||
+            in[file_magic.size()] != file_version)
+            return std::unexpected(error_code::invalid_format);
+
+        pointer_chains chains;
+        chains.pointer_size = in[file_magic.size() + 1];
+        if (chains.pointer_size != sizeof(std::uint32_t) && chains.pointer_size != sizeof(std::uint64_t))
+            return std::unexpected(error_code::invalid_format);
+
+        std::size_t pos = file_magic.size() + 2;
+
+        // counts are checked against the bytes left before anything is sized by them
+        const auto module_count = get_varint(in, pos);
+        if (!module_count || *module_count > in.size() - pos)
+            return std::unexpected(error_code::invalid_format);
+        for (std::uint64_t i = 0; i < *module_count; ++i) {
+            const auto length = get_varint(in, pos);
+            if (!length || *length > in.size() - pos)
+                return std::unexpected(error_code::invalid_format);
+            chains.modules.emplace_back(in.begin() + static_cast<std::ptrdiff_t>(pos),
+                                        in.begin() + static_cast<std::ptrdiff_t>(pos + *length));
+            pos += *length;
+        }
+
+        const auto chain_count = get_varint(in, pos);
+        if (!chain_count || *chain_count > in.size() - pos)
+            return std::unexpected(error_code::invalid_format);
+        chains.chains.reserve(*chain_count);
+        for (std::uint64_t i = 0; i < *chain_count; ++i) {
+            const auto module = get_varint(in, pos);
+            const auto base_offset = get_varint(in, pos);
+            const auto depth = get_varint(in, pos);
+            if (!module || !base_offset || !depth || *module >= chains.modules.size() || *depth > max_file_depth)
+                return std::unexpected(error_code::invalid_format);
+
+            auto& chain = chains.chains.emplace_back();
+            chain.module = static_cast<std::uint32_t>(*module);
+            chain.base_offset = *base_offset;
+            for (std::uint64_t d = 0; d < *depth; ++d) {
+                const auto offset = get_varint(in, pos);
+                if (!offset || *offset > UINT32_MAX)
+                    return std::unexpected(error_code::invalid_format);
+                chain.offsets.push_back(static_cast<std::uint32_t>(*offset));
+            }
+        }
+        return chains;
+    }
+} // namespace core
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/target.h"
+
+namespace core {
+    struct pointer_scan_config {
+        std::uintptr_t address = 0;         // where every chain has to end
+        std::size_t max_depth = 5;          // dereferences per chain
+        std::size_t max_offset = 0x1000;    // largest offset added to a pointer before the next step
+        std::size_t pointer_size = 8;       // 4 for 32 bit targets
+        bool aligned = true;                // pointers are only looked for at multiples of pointer_size
+        std::size_t max_chains = 1'000'000; // the walk stops listing chains past this
+    };
+
+    // start at a module relative address, then dereference and add the next offset once per entry. the last
+    // offset lands on the address that was scanned for
+    struct pointer_chain {
+        std::uint32_t module = 0; // index into pointer_chains::modules
+        std::uint64_t base_offset = 0;
+        std::vector<std::uint32_t> offsets;
+    };
+
+    struct pointer_chains {
+        std::size_t pointer_size = 8;
+        std::vector<std::string> modules; // file names only, a module keeps its name when its path or base moves
+        std::vector<pointer_chain> chains;
+    };
+
+    // finds chains of pointers from module images to an address, so it can be found again once a restart has moved
+    // the heap. one parallel pass over readable memory collects every value pointing into a readable region, sorted
+    // by value, and a breadth first walk backwards from the address follows those down to static locations
+    class pointer_scanner {
+    public:
+        explicit pointer_scanner(target* t);
+        ~pointer_scanner();
+
+        pointer_scanner(const pointer_scanner&) = delete;
+        pointer_scanner& operator=(const pointer_scanner&) = delete;
+        pointer_scanner(pointer_scanner&&) = delete;
+        pointer_scanner& operator=(pointer_scanner&&) = delete;
+
+        void set_target(target* t);
+
+        std::unique_lock<std::mutex> lock_results() const;
+
+        void begin_scan(const pointer_scan_config& config);
+        void cancel();
+
+        float progress() const;
+        bool is_scanning() const;
+
+        const pointer_chains& get_results() const;
+
+        // where each module of chains is loaded in t now, nullopt for the ones that aren't
+        static std::vector<std::optional<std::uintptr_t>> locate_modules(target& t, const pointer_chains& chains);
+
+        // follows chain through t, nullopt when its module isn't loaded or a pointer on the way can't be read
+        static std::optional<std::uintptr_t> resolve(
+                target& t, std::span<const std::optional<std::uintptr_t>> bases, std::size_t pointer_size,
+                const pointer_chain& chain
+        );
+
+        // the chains that still end at address in t, typically a new instance with the value found again
+        static pointer_chains revalidate(target& t, const pointer_chains& chains, std::uintptr_t address);
+
+        // varint packed file, a few bytes per chain
+        static std::expected<void, error_code> save(const std::filesystem::path& path, const pointer_chains& chains);
+        static std::expected<pointer_chains, error_code> load(const std::filesystem::path& path);
+
+    private:
+        void worker_scan(pointer_scan_config config);
+
+        target* active_target;
+
+        pointer_chains results;
+        mutable std::mutex results_mutex;
+
+        std::atomic<bool> scanning = false;
+        std::atomic<bool> cancel_req = false;
+        std::atomic<float> progress_val = 0.0f;
+
+        std::jthread scan_thread;
+    };
+} // namespace core
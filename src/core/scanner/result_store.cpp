@@ -0,0 +1,265 @@
+#include <core/scanner/result_store.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include "util/mapped_file.h"
+
+namespace core {
+    namespace {
+        constexpr std::size_t block_size = 4 * 1024 * 1024;
+
+        std::size_t round_up(std::size_t value, std::size_t to) {
+            return (value + to - 1) / to * to;
+        }
+
+        std::size_t bitmap_words(std::uint32_t extent, std::uint32_t align) {
+            return extent / align / 64 + 1;
+        }
+
+        std::size_t bitmap_bytes(std::uint32_t extent, std::uint32_t align) {
+            const std::size_t words = bitmap_words(extent, align);
+            const std::size_t ranks = (words + result_store::rank_words - 1) / result_store::rank_words;
+            return words * sizeof(std::uint64_t) + ranks * sizeof(std::uint32_t);
+        }
+
+        std::size_t decode(const result_store::segment& seg, std::size_t local, std::span<std::uintptr_t> out) {
+            const std::size_t count = std::min<std::size_t>(out.size(), seg.count - local);
+
+            if (seg.kind == result_store::encoding::offsets) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    out[i] = seg.base + seg.offsets[local + i];
+                }
+                return count;
+            }
+
+            // find the rank block holding the local-th bit, then walk words from there
+            const std::size_t words = bitmap_words(seg.extent, seg.align);
+            const std::size_t blocks = (words + result_store::rank_words - 1) / result_store::rank_words;
+            const std::uint32_t* rank = std::upper_bound(seg.ranks, seg.ranks + blocks, local) - 1;
+
+            std::size_t word = static_cast<std::size_t>(rank - seg.ranks) * result_store::rank_words;
+            std::size_t seen = *rank;
+            while (seen + static_cast<std::size_t>(std::popcount(seg.bits[word])) <= local) {
+                seen += static_cast<std::size_t>(std::popcount(seg.bits[word]));
+                ++word;
+            }
+
+            std::uint64_t bits = seg.bits[word];
+            for (std::size_t skip = local - seen; skip > 0; --skip) {
+                bits &= bits - 1;
+            }
+
+            std::size_t written = 0;
+            while (written < count) {
+                while (bits == 0) {
+                    bits = seg.bits[++word];
+                }
+                const std::size_t slot = word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                out[written++] = seg.base + slot * seg.align;
+                bits &= bits - 1;
+            }
+            return written;
+        }
+    } // namespace
+
+    // bump allocator over stable blocks, so segment pointers survive moving the store around
+    struct result_store::arena {
+        explicit arena(std::size_t budget) : limit(budget) {
+        }
+
+        std::byte* allocate(std::size_t bytes) {
+            bytes = round_up(bytes, alignof(std::uint64_t));
+
+            std::lock_guard lock(mutex);
+            if (bytes > remaining) {
+                grow(std::max(bytes, block_size));
+            }
+
+            std::byte* ptr = cursor;
+            cursor += bytes;
+            remaining -= bytes;
+            return ptr;
+        }
+
+        void grow(std::size_t size) {
+            if (heap_bytes + size > limit) {
+                if (!spill) {
+                    if (auto file = scratch_file::create()) {
+                        spill.emplace(std::move(*file));
+                    }
+                }
+
+                if (spill) {
+                    if (auto region = spill->extend(size)) {
+                        auto bytes = region->bytes();
+                        mapped.push_back(std::move(*region));
+                        spilled_bytes += bytes.size();
+                        cursor = bytes.data();
+                        remaining = bytes.size();
+                        return;
+                    }
+                }
+                // no scratch space to be had, going over budget beats dropping results
+            }
+
+            heap.push_back(std::make_unique_for_overwrite<std::byte[]>(size));
+            heap_bytes += size;
+            cursor = heap.back().get();
+            remaining = size;
+        }
+
+        std::mutex mutex;
+        std::size_t limit;
+
+        std::vector<std::unique_ptr<std::byte[]>> heap;
+        std::size_t heap_bytes = 0;
+
+        std::optional<scratch_file> spill;
+        std::vector<mapped_region> mapped;
+        std::size_t spilled_bytes = 0;
+
+        std::byte* cursor = nullptr;
+        std::size_t remaining = 0;
+    };
+
+    result_store::result_store(std::size_t memory_budget) :
+        m_budget(memory_budget), m_arena(std::make_unique<arena>(memory_budget)) {
+    }
+
+    result_store::~result_store() = default;
+    result_store::result_store(result_store&& other) noexcept = default;
+    result_store& result_store::operator=(result_store&& other) noexcept = default;
+
+    result_store::segment result_store::encode(
+            std::uintptr_t base, std::size_t align, std::span<const std::uint32_t> offsets,
+            std::span<const std::byte> values, std::uint8_t tag
+    ) {
+        segment seg;
+        if (offsets.empty())
+            return seg;
+
+        seg.tag = tag;
+
+        if (!values.empty()) {
+            auto* out = m_arena->allocate(values.size());
+            std::memcpy(out, values.data(), values.size());
+            seg.values = out;
+            seg.value_size = static_cast<std::uint32_t>(values.size() / offsets.size());
+        }
+
+        const std::uint32_t first = offsets.front();
+        seg.base = base + first;
+        seg.count = static_cast<std::uint32_t>(offsets.size());
+        seg.extent = offsets.back() - first;
+
+        // the bitmap needs every hit on a slot boundary, anything else falls back to byte slots
+        seg.align = static_cast<std::uint32_t>(std::max<std::size_t>(align, 1));
+        for (const auto offset : offsets) {
+            if ((offset - first) % seg.align != 0) {
+                seg.align = 1;
+                break;
+            }
+        }
+
+        const std::size_t list_size = offsets.size() * sizeof(std::uint32_t);
+        if (bitmap_bytes(seg.extent, seg.align) >= list_size) {
+            auto* out = reinterpret_cast<std::uint32_t*>(m_arena->allocate(list_size));
+            for (std::size_t i = 0; i < offsets.size(); ++i) {
+                out[i] = offsets[i] - first;
+            }
+            seg.offsets = out;
+            return seg;
+        }
+
+        const std::size_t words = bitmap_words(seg.extent, seg.align);
+        const std::size_t blocks = (words + rank_words - 1) / rank_words;
+        auto* storage = m_arena->allocate(bitmap_bytes(seg.extent, seg.align));
+        auto* bits = reinterpret_cast<std::uint64_t*>(storage);
+        auto* ranks = reinterpret_cast<std::uint32_t*>(storage + words * sizeof(std::uint64_t));
+
+        std::memset(bits, 0, words * sizeof(std::uint64_t));
+        for (const auto offset : offsets) {
+            const std::size_t slot = (offset - first) / seg.align;
+            bits[slot / 64] |= std::uint64_t{1} << (slot % 64);
+        }
+
+        std::uint32_t running = 0;
+        for (std::size_t b = 0; b < blocks; ++b) {
+            ranks[b] = running;
+            for (std::size_t w = b * rank_words; w < std::min(words, (b + 1) * rank_words); ++w) {
+                running += static_cast<std::uint32_t>(std::popcount(bits[w]));
+            }
+        }
+
+        seg.kind = encoding::bitmap;
+        seg.bits = bits;
+        seg.ranks = ranks;
+        return seg;
+    }
+
+    void result_store::push(segment seg) {
+        if (seg.count == 0)
+            return;
+
+        seg.first_index = m_size;
+        m_size += seg.count;
+        m_segments.push_back(seg);
+    }
+
+    std::uintptr_t result_store::address(std::size_t index) const {
+        std::uintptr_t out = 0;
+        read(index, std::span(&out, 1));
+        return out;
+    }
+
+    std::uint8_t result_store::tag(std::size_t index) const {
+        if (index >= m_size)
+            return 0;
+        return (std::ranges::upper_bound(m_segments, index, {}, &segment::first_index) - 1)->tag;
+    }
+
+    std::size_t result_store::read(
+            std::size_t index, std::span<std::uintptr_t> out, std::span<std::byte> values, std::size_t value_size
+    ) const {
+        if (index >= m_size)
+            return 0;
+
+        auto it = std::ranges::upper_bound(m_segments, index, {}, &segment::first_index) - 1;
+
+        std::size_t written = 0;
+        for (; it != m_segments.end() && written < out.size(); ++it) {
+            const std::size_t local = index + written - it->first_index;
+            const std::size_t count = decode(*it, local, out.subspan(written));
+
+            if (!values.empty()) {
+                auto dst = values.subspan(written * value_size, count * value_size);
+                if (it->value_size == value_size) {
+                    std::memcpy(dst.data(), it->values + local * value_size, dst.size());
+                } else {
+                    std::ranges::fill(dst, std::byte{0});
+                }
+            }
+            written += count;
+        }
+        return written;
+    }
+
+    std::size_t result_store::memory_bytes() const {
+        return m_arena->heap_bytes + m_segments.capacity() * sizeof(segment);
+    }
+
+    std::size_t result_store::spilled_bytes() const {
+        return m_arena->spilled_bytes;
+    }
+
+    void result_store::clear() {
+        m_segments.clear();
+        m_segments.shrink_to_fit();
+        m_size = 0;
+        m_arena = std::make_unique<arena>(m_budget);
+    }
+} // namespace core
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace core {
+    // scan hits grouped into region relative segments. each segment keeps either 32 bit offsets from its base or,
+    // when the hits are dense enough for it to be smaller, one bit per aligned slot. storage comes from an arena
+    // that moves over to a scratch file once the heap part passes the memory budget
+    class result_store {
+    public:
+        static constexpr std::size_t default_memory_budget = 512ull * 1024 * 1024;
+
+        enum class encoding : std::uint8_t {
+            offsets,
+            bitmap
+        };
+
+        struct segment {
+            std::uintptr_t base = 0;     // address of the first hit
+            std::size_t first_index = 0; // index of the first hit across the whole store, set by push()
+            std::uint32_t count = 0;
+            std::uint32_t extent = 0; // offset of the last hit
+            std::uint32_t align = 1;  // bitmap slot width
+            encoding kind = encoding::offsets;
+            const std::uint32_t* offsets = nullptr;
+            const std::uint64_t* bits = nullptr;
+            const std::uint32_t* ranks = nullptr; // set bits before every rank_words words of the bitmap
+            const std::byte* values = nullptr;    // value_size bytes per hit, in hit order
+            std::uint32_t value_size = 0;
+            std::uint8_t tag = 0; // what the hits are, up to the scan that found them. 0 when it doesn't say
+        };
+
+        static constexpr std::size_t rank_words = 8;
+
+        explicit result_store(std::size_t memory_budget = default_memory_budget);
+        ~result_store();
+
+        result_store(result_store&& other) noexcept;
+        result_store& operator=(result_store&& other) noexcept;
+        result_store(const result_store&) = delete;
+        result_store& operator=(const result_store&) = delete;
+
+        // packs sorted offsets relative to base, and optionally the value read at each of them, into storage owned
+        // by this store. safe to call from several threads, the segment only becomes visible once it is pushed
+        [[nodiscard]] segment encode(
+                std::uintptr_t base, std::size_t align, std::span<const std::uint32_t> offsets,
+                std::span<const std::byte> values = {}, std::uint8_t tag = 0
+        );
+
+        // appends a segment from encode(). segments have to be pushed in address order, or in address order per tag
+        // with every segment of a tag next to each other
+        void push(segment seg);
+
+        [[nodiscard]] std::size_t size() const {
+            return m_size;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] std::uintptr_t address(std::size_t index) const;
+        [[nodiscard]] std::uint8_t tag(std::size_t index) const;
+
+        // decodes addresses starting at index into out, returns how many were written. values, when given, gets
+        // value_size bytes per address from the segments that kept them and zeroes from the ones that didn't
+        std::size_t read(
+                std::size_t index, std::span<std::uintptr_t> out, std::span<std::byte> values = {},
+                std::size_t value_size = 0
+        ) const;
+
+        [[nodiscard]] std::span<const segment> segments() const {
+            return m_segments;
+        }
+
+        [[nodiscard]] std::size_t memory_budget() const {
+            return m_budget;
+        }
+        [[nodiscard]] std::size_t memory_bytes() const;
+        [[nodiscard]] std::size_t spilled_bytes() const;
+
+        void clear();
+
+    private:
+        struct arena;
+
+        std::size_t m_budget;
+        std::unique_ptr<arena> m_arena;
+        std::vector<segment> m_segments;
+        std::size_t m_size = 0;
+    };
+} // namespace core
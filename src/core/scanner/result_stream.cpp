@@ -0,0 +1,85 @@
+#include <core/scanner/result_stream.h>
+
+#include <algorithm>
+
+namespace core {
+    result_stream::~result_stream() {
+        clear();
+    }
+
+    void result_stream::append(cursor& at, std::uintptr_t base, std::span<const std::uint32_t> offsets) {
+        m_found.fetch_add(offsets.size(), std::memory_order_relaxed);
+
+        while (!offsets.empty()) {
+            if (!at.current || at.current->count.load(std::memory_order_relaxed) == chunk_entries) {
+                at.current = grab();
+                if (!at.current)
+                    return;
+            }
+
+            // only this cursor writes to the chunk, the release store is what hands the new entries to readers
+            auto* c = at.current;
+            const std::uint32_t used = c->count.load(std::memory_order_relaxed);
+            const std::size_t n = std::min<std::size_t>(chunk_entries - used, offsets.size());
+            for (std::size_t i = 0; i < n; ++i) {
+                c->addresses[used + i] = base + offsets[i];
+            }
+            c->count.store(used + static_cast<std::uint32_t>(n), std::memory_order_release);
+            offsets = offsets.subspan(n);
+        }
+    }
+
+    result_stream::chunk* result_stream::grab() {
+        const std::size_t slot = m_used.fetch_add(1, std::memory_order_relaxed);
+        if (slot >= max_chunks)
+            return nullptr;
+
+        auto* c = new chunk;
+        m_chunks[slot].store(c, std::memory_order_release);
+        return c;
+    }
+
+    std::size_t result_stream::chunk_count() const {
+        return std::min(m_used.load(std::memory_order_relaxed), max_chunks);
+    }
+
+    std::size_t result_stream::size() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < chunk_count(); ++i) {
+            // a slot can be claimed before its chunk is stored, it holds nothing yet either way
+            if (const auto* c = m_chunks[i].load(std::memory_order_acquire)) {
+                total += c->count.load(std::memory_order_acquire);
+            }
+        }
+        return total;
+    }
+
+    std::size_t result_stream::read(std::size_t index, std::span<std::uintptr_t> out) const {
+        std::size_t written = 0;
+        for (std::size_t i = 0; i < chunk_count() && written < out.size(); ++i) {
+            const auto* c = m_chunks[i].load(std::memory_order_acquire);
+            if (!c)
+                continue;
+
+            const std::size_t count = c->count.load(std::memory_order_acquire);
+            if (index >= count) {
+                index -= count;
+                continue;
+            }
+
+            const std::size_t n = std::min(count - index, out.size() - written);
+            std::copy_n(c->addresses.data() + index, n, out.data() + written);
+            written += n;
+            index = 0;
+        }
+        return written;
+    }
+
+    void result_stream::clear() {
+        for (std::size_t i = 0; i < chunk_count(); ++i) {
+            delete m_chunks[i].exchange(nullptr, std::memory_order_relaxed);
+        }
+        m_used.store(0, std::memory_order_relaxed);
+        m_found.store(0, std::memory_order_relaxed);
+    }
+} // namespace core
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace core {
+    // hits of a scan that is still running, so they can be shown before it finishes. every worker appends into
+    // fixed size chunks of its own and publishes them by count, readers see a prefix of each chunk without taking
+    // any lock, and neither side ever waits for the other. order is whatever the workers found things in and an
+    // index can move while chunks before it still grow, the sorted result_store replaces this once the scan is done
+    class result_stream {
+        struct chunk;
+
+    public:
+        static constexpr std::size_t chunk_entries = 4096;
+        static constexpr std::size_t max_chunks = 256; // hits past this many chunks are only counted
+
+        // where one worker is appending, a cursor must not be shared between threads
+        struct cursor {
+            chunk* current = nullptr;
+        };
+
+        result_stream() = default;
+        ~result_stream();
+
+        result_stream(const result_stream&) = delete;
+        result_stream& operator=(const result_stream&) = delete;
+        result_stream(result_stream&&) = delete;
+        result_stream& operator=(result_stream&&) = delete;
+
+        // publishes base + offset for every offset
+        void append(cursor& at, std::uintptr_t base, std::span<const std::uint32_t> offsets);
+
+        // addresses readable right now. counts only grow, so an index below an earlier size() stays readable
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] bool empty() const {
+            return size() == 0;
+        }
+
+        // every hit appended, including the ones past the last chunk
+        [[nodiscard]] std::size_t found() const {
+            return m_found.load(std::memory_order_relaxed);
+        }
+
+        // copies addresses starting at index into out, returns how many were written
+        std::size_t read(std::size_t index, std::span<std::uintptr_t> out) const;
+
+        // not safe against anyone appending or reading at the same time
+        void clear();
+
+    private:
+        struct chunk {
+            std::atomic<std::uint32_t> count = 0;
+            std::array<std::uintptr_t, chunk_entries> addresses;
+        };
+
+        chunk* grab();
+        [[nodiscard]] std::size_t chunk_count() const;
+
+        std::array<std::atomic<chunk*>, max_chunks> m_chunks{};
+        std::atomic<std::size_t> m_used = 0;
+        std::atomic<std::size_t> m_found = 0;
+    };
+} // namespace core
@@ -1,12 +1,31 @@
+#include <core/scanner/pattern.h>
 #include <core/scanner/scanner.h>
+#include <core/scanner/session.h>
+#include <core/scanner/simd.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
 #include <cstring>
+#include <functional>
+#include <limits>
 #include <mutex>
 #include <optional>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include "core/target.h"
+#include "util/affinity.h"
+#include "util/thread_pool.h"
 
 namespace core {
     namespace {
+        constexpr std::uintptr_t page_size = 0x1000;
+        constexpr std::size_t chunk_size = 1024 * 1024; // 1mb chunks
+        constexpr std::size_t task_size = 16 * chunk_size;
+        constexpr std::size_t block_size = 64 * 1024; // what numeric scans run every type over while it's cached
+
         template <typename T>
         T read_at(const void* ptr) {
             T val;
@@ -16,28 +35,242 @@ namespace core {
 
         template <typename T>
         struct exact_matcher {
+            static constexpr simd::predicate op = simd::predicate::eq;
+            static constexpr simd::source src = simd::source::constant;
             T target;
-            bool operator()(T val) const {
+            bool operator()(T val, T) const {
                 return val == target;
             }
         };
 
+        template <typename T>
+        struct not_equal_matcher {
+            static constexpr simd::predicate op = simd::predicate::ne;
+            static constexpr simd::source src = simd::source::constant;
+            T target;
+            bool operator()(T val, T) const {
+                return val != target;
+            }
+        };
+
         template <typename T>
         struct greater_matcher {
+            static constexpr simd::predicate op = simd::predicate::gt;
+            static constexpr simd::source src = simd::source::constant;
             T target;
-            bool operator()(T val) const {
+            bool operator()(T val, T) const {
                 return val > target;
             }
         };
 
         template <typename T>
         struct less_matcher {
+            static constexpr simd::predicate op = simd::predicate::lt;
+            static constexpr simd::source src = simd::source::constant;
             T target;
-            bool operator()(T val) const {
+            bool operator()(T val, T) const {
                 return val < target;
             }
         };
 
+        // rounded, truncated and approx are ranges too, parse_input works out their bounds
+        template <typename T>
+        struct between_matcher {
+            static constexpr simd::predicate op = simd::predicate::between;
+            static constexpr simd::source src = simd::source::constant;
+            T target;
+            T bound;
+            bool operator()(T val, T) const {
+                return target <= val && val <= bound;
+            }
+        };
+
+        template <typename T>
+        struct changed_matcher {
+            static constexpr simd::predicate op = simd::predicate::ne;
+            static constexpr simd::source src = simd::source::previous;
+            bool operator()(T val, T prev) const {
+                return val != prev;
+            }
+        };
+
+        template <typename T>
+        struct unchanged_matcher {
+            static constexpr simd::predicate op = simd::predicate::eq;
+            static constexpr simd::source src = simd::source::previous;
+            bool operator()(T val, T prev) const {
+                return val == prev;
+            }
+        };
+
+        template <typename T>
+        struct increased_matcher {
+            static constexpr simd::predicate op = simd::predicate::gt;
+            static constexpr simd::source src = simd::source::previous;
+            bool operator()(T val, T prev) const {
+                return val > prev;
+            }
+        };
+
+        template <typename T>
+        struct decreased_matcher {
+            static constexpr simd::predicate op = simd::predicate::lt;
+            static constexpr simd::source src = simd::source::previous;
+            bool operator()(T val, T prev) const {
+                return val < prev;
+            }
+        };
+
+        // two's complement wrap for integers, the way the target's own arithmetic would
+        template <typename T>
+        T wrapping_add(T a, T b) {
+            if constexpr (std::is_integral_v<T>) {
+                using unsigned_type = std::make_unsigned_t<T>;
+                return static_cast<T>(static_cast<unsigned_type>(a) + static_cast<unsigned_type>(b));
+            } else {
+                return a + b;
+            }
+        }
+
+        template <typename T>
+        T wrapping_sub(T a, T b) {
+            if constexpr (std::is_integral_v<T>) {
+                using unsigned_type = std::make_unsigned_t<T>;
+                return static_cast<T>(static_cast<unsigned_type>(a) - static_cast<unsigned_type>(b));
+            } else {
+                return a - b;
+            }
+        }
+
+        // b is never negative here
+        template <typename T>
+        T saturating_sub(T a, T b) {
+            if constexpr (std::is_integral_v<T>) {
+                return a < std::numeric_limits<T>::lowest() + b ? std::numeric_limits<T>::lowest()
+                                                                : static_cast<T>(a - b);
+            } else {
+                return a - b;
+            }
+        }
+
+        template <typename T>
+        T saturating_add(T a, T b) {
+            if constexpr (std::is_integral_v<T>) {
+                return a > std::numeric_limits<T>::max() - b ? std::numeric_limits<T>::max() : static_cast<T>(a + b);
+            } else {
+                return a + b;
+            }
+        }
+
+        // relative matchers with lower() (and upper() for between) compare against those applied to the previous
+        // value instead of the previous value itself
+        template <typename T>
+        struct increased_by_matcher {
+            static constexpr simd::predicate op = simd::predicate::eq;
+            static constexpr simd::source src = simd::source::previous;
+            T amount;
+            T lower(T prev) const {
+                return wrapping_add(prev, amount);
+            }
+            bool operator()(T val, T prev) const {
+                return val == lower(prev);
+            }
+        };
+
+        template <typename T>
+        struct decreased_by_matcher {
+            static constexpr simd::predicate op = simd::predicate::eq;
+            static constexpr simd::source src = simd::source::previous;
+            T amount;
+            T lower(T prev) const {
+                return wrapping_sub(prev, amount);
+            }
+            bool operator()(T val, T prev) const {
+                return val == lower(prev);
+            }
+        };
+
+        template <typename T>
+        struct within_matcher {
+            static constexpr simd::predicate op = simd::predicate::between;
+            static constexpr simd::source src = simd::source::previous;
+            T epsilon;
+            T lower(T prev) const {
+                return saturating_sub(prev, epsilon);
+            }
+            T upper(T prev) const {
+                return saturating_add(prev, epsilon);
+            }
+            bool operator()(T val, T prev) const {
+                return lower(prev) <= val && val <= upper(prev);
+            }
+        };
+
+        template <typename T, typename Matcher>
+        simd::operands<T> operands_for(
+                const Matcher& matcher, const std::byte* previous, const std::byte* previous_upper = nullptr
+        ) {
+            if constexpr (Matcher::src == simd::source::previous) {
+                return {.value = T{}, .upper = T{}, .previous = previous, .previous_upper = previous_upper};
+            } else if constexpr (requires { matcher.bound; }) {
+                return {.value = matcher.target,
+                        .upper = matcher.bound,
+                        .previous = nullptr,
+                        .previous_upper = nullptr};
+            } else {
+                return {.value = matcher.target, .upper = T{}, .previous = nullptr, .previous_upper = nullptr};
+            }
+        }
+
+        // calls func with the matcher for type, unknown doesn't filter anything and gets none. bound is the upper
+        // end for the range modes
+        template <typename T, typename Func>
+        void dispatch_compare(scan_compare_type type, T target, T bound, Func&& func) {
+            switch (type) {
+                case scan_compare_type::exact:
+                    func(exact_matcher<T>{target});
+                    break;
+                case scan_compare_type::not_equal:
+                    func(not_equal_matcher<T>{target});
+                    break;
+                case scan_compare_type::greater:
+                    func(greater_matcher<T>{target});
+                    break;
+                case scan_compare_type::less:
+                    func(less_matcher<T>{target});
+                    break;
+                case scan_compare_type::between:
+                case scan_compare_type::rounded:
+                case scan_compare_type::truncated:
+                case scan_compare_type::approx:
+                    func(between_matcher<T>{target, bound});
+                    break;
+                case scan_compare_type::changed:
+                    func(changed_matcher<T>{});
+                    break;
+                case scan_compare_type::unchanged:
+                    func(unchanged_matcher<T>{});
+                    break;
+                case scan_compare_type::increased:
+                    func(increased_matcher<T>{});
+                    break;
+                case scan_compare_type::decreased:
+                    func(decreased_matcher<T>{});
+                    break;
+                case scan_compare_type::increased_by:
+                    func(increased_by_matcher<T>{target});
+                    break;
+                case scan_compare_type::decreased_by:
+                    func(decreased_by_matcher<T>{target});
+                    break;
+                case scan_compare_type::within:
+                    func(within_matcher<T>{target});
+                    break;
+                case scan_compare_type::unknown:
+                    break;
+            }
+        }
+
         template <typename Func>
         void dispatch_scan_type(scan_data_type type, Func&& func) {
             switch (type) {
@@ -72,11 +305,497 @@ namespace core {
                 case scan_data_type::f64:
                     func.template operator()<double>();
                     break;
+                case scan_data_type::bytes:
+                case scan_data_type::group:
+                case scan_data_type::numeric:
+                    // no element type, these have their own workers
+                    break;
+            }
+        }
+
+        // regions are split into tasks on chunk boundaries, so the values covered are the same as a
+        // sequential walk and concatenating the per-task output in task order keeps address order
+        struct scan_task {
+            std::size_t region;
+            std::uintptr_t base;
+            std::size_t size;
+        };
+
+        template <typename Regions, typename Extent>
+        std::vector<scan_task> split_tasks(const Regions& regions, Extent extent) {
+            std::vector<scan_task> tasks;
+            for (std::size_t i = 0; i < std::size(regions); ++i) {
+                const auto [base, size] = extent(regions[i]);
+                for (std::size_t offset = 0; offset < size; offset += task_size) {
+                    tasks.push_back({i, base + offset, std::min(task_size, size - offset)});
+                }
+            }
+            return tasks;
+        }
+
+        // fills a chunk of the snapshot, copying the pages nothing wrote to since generation out of the previous one
+        // and reading only the runs of written pages, all in one batch. false when one of those can't be read
+        bool read_written(
+                target& t, std::uintptr_t address, std::span<std::byte> view, const snapshot& prev,
+                std::span<const snapshot::page> pages, std::uint32_t generation, std::vector<read_request>& requests,
+                const std::atomic<bool>& cancel
+        ) {
+            requests.clear();
+            for (std::size_t i = 0; i < pages.size(); ++i) {
+                const std::size_t at = i * snapshot::page_size;
+                const std::size_t size = std::min(snapshot::page_size, view.size() - at);
+
+                if (t.written_since(address + at, size, generation)) {
+                    auto* last = requests.empty() ? nullptr : &requests.back();
+                    if (last && last->address + last->buffer.size() == address + at) {
+                        last->buffer = view.subspan(last->address - address, last->buffer.size() + size);
+                    } else {
+                        requests.push_back({address + at, view.subspan(at, size)});
+                    }
+                } else if (pages[i].data != snapshot::none) {
+                    std::memcpy(view.data() + at, prev.data(pages[i].data), size);
+                } else {
+                    std::memset(view.data() + at, 0, size);
+                }
+            }
+            std::size_t bytes = 0;
+            for (const auto& r : requests) {
+                bytes += r.buffer.size();
+            }
+            return t.budget().acquire(bytes, t.batch_calls(requests.size()), cancel) &&
+                   t.read_memory_batch(requests) == requests.size();
+        }
+
+        // lists the candidates left in a snapshot, together with the value each one had when it was taken
+        template <typename T>
+        result_store materialize(const snapshot& snap, std::size_t memory_budget) {
+            constexpr std::size_t pages_per_chunk = chunk_size / snapshot::page_size;
+
+            result_store store(memory_budget);
+            std::vector<std::uint32_t> offsets;
+            std::vector<std::byte> values;
+
+            for (const auto& region : snap.regions()) {
+                for (std::size_t first = 0; first < region.pages.size(); first += pages_per_chunk) {
+                    offsets.clear();
+                    values.clear();
+
+                    const std::size_t last = std::min(region.pages.size(), first + pages_per_chunk);
+                    for (std::size_t i = first; i < last; ++i) {
+                        if (region.pages[i].mask == snapshot::none)
+                            continue;
+
+                        for (std::size_t in_page = 0; in_page < snapshot::page_size; in_page += snap.align()) {
+                            const std::size_t at = i * snapshot::page_size + in_page;
+                            if (at + sizeof(T) > region.size)
+                                break;
+                            if (!snap.is_candidate(region.pages[i], in_page))
+                                continue;
+
+                            offsets.push_back(static_cast<std::uint32_t>(at - first * snapshot::page_size));
+
+                            // the value may run into the next page
+                            for (std::size_t b = at; b < at + sizeof(T); ++b) {
+                                const auto& page = region.pages[b / snapshot::page_size];
+                                values.push_back(
+                                        page.data != snapshot::none ? snap.data(page.data)[b % snapshot::page_size]
+                                                                    : std::byte{0}
+                                );
+                            }
+                        }
+                    }
+
+                    store.push(store.encode(region.base + first * snapshot::page_size, snap.align(), offsets, values));
+                }
+            }
+            return store;
+        }
+
+        // the upper bound parse_input gave for a range mode, or the value itself for every other mode
+        template <typename T>
+        T bound_of(const std::vector<std::byte>& operands) {
+            return read_at<T>(operands.data() + (operands.size() >= 2 * sizeof(T) ? sizeof(T) : 0));
+        }
+
+        template <typename T>
+        std::vector<std::byte> pack_range(T lower, T upper) {
+            std::vector<std::byte> bytes(2 * sizeof(T));
+            std::memcpy(bytes.data(), &lower, sizeof(T));
+            std::memcpy(bytes.data() + sizeof(T), &upper, sizeof(T));
+            return bytes;
+        }
+
+        // the bounds are decimal, the T nearest to each one stands in for it so a value displayed as the bound
+        // counts as the bound itself
+        template <typename T>
+        std::vector<std::byte> narrow_range(long double lower, bool lower_open, long double upper, bool upper_open) {
+            T lo = static_cast<T>(lower);
+            if (lower_open)
+                lo = std::nextafter(lo, std::numeric_limits<T>::infinity());
+
+            T hi = static_cast<T>(upper);
+            if (upper_open)
+                hi = std::nextafter(hi, -std::numeric_limits<T>::infinity());
+
+            return pack_range(lo, hi);
+        }
+
+        // a group field resolved to its matcher. prefilter runs the simd kernel for it over bytes laid out so hit k
+        // is a group starting at k, check tests one field in place
+        struct group_field {
+            std::size_t offset = 0;
+            std::size_t size = 0;
+            int selectivity = 0;
+            std::function<bool(const std::byte*)> check;
+            std::function<std::size_t(std::span<const std::byte>, std::size_t, std::uint32_t*)> prefilter;
+        };
+
+        // rough odds of a field ruling out a random address, exact compares on wide types rule out the most
+        int selectivity(scan_compare_type compare, std::size_t size) {
+            int rank = 0;
+            switch (compare) {
+                case scan_compare_type::exact:
+                    rank = 3;
+                    break;
+                case scan_compare_type::between:
+                case scan_compare_type::rounded:
+                case scan_compare_type::truncated:
+                case scan_compare_type::approx:
+                    rank = 2;
+                    break;
+                case scan_compare_type::greater:
+                case scan_compare_type::less:
+                    rank = 1;
+                    break;
+                default:
+                    break;
+            }
+            return rank * 16 + static_cast<int>(size);
+        }
+
+        // the fields in the order they get checked, the most selective first
+        std::optional<std::vector<group_field>> plan_group(std::span<const scan_field> fields) {
+            std::vector<group_field> plan;
+            for (const auto& field : fields) {
+                // there is only one previous address per group, no previous value per field
+                if (field.type == scan_data_type::bytes || field.type == scan_data_type::group ||
+                    scanner::is_relative(field.compare) || field.compare == scan_compare_type::unknown)
+                    return std::nullopt;
+
+                const auto operands = scanner::parse_input(field.value_str, field.type, field.compare);
+                if (!operands)
+                    return std::nullopt;
+
+                auto& entry = plan.emplace_back();
+                entry.offset = field.offset;
+                entry.size = scanner::type_size(field.type);
+                entry.selectivity = selectivity(field.compare, entry.size);
+
+                dispatch_scan_type(field.type, [&]<typename T>() {
+                    const T target = read_at<T>(operands->data());
+                    dispatch_compare(field.compare, target, bound_of<T>(*operands), [&](auto matcher) {
+                        using matcher_type = decltype(matcher);
+                        if constexpr (matcher_type::src == simd::source::constant) {
+                            entry.check = [matcher](const std::byte* at) {
+                                return matcher(read_at<T>(at), T{});
+                            };
+                            entry.prefilter = [matcher, kernel = simd::select<T>(matcher_type::op)](
+                                                      std::span<const std::byte> data, std::size_t align,
+                                                      std::uint32_t* out
+                                              ) {
+                                return kernel(data, align, operands_for<T>(matcher, nullptr), out);
+                            };
+                        }
+                    });
+                });
+            }
+
+            if (plan.empty())
+                return std::nullopt;
+
+            std::ranges::stable_sort(plan, std::greater{}, &group_field::selectivity);
+            return plan;
+        }
+
+        // bytes from the group start to the end of its furthest field
+        std::size_t group_extent(std::span<const group_field> plan) {
+            std::size_t extent = 0;
+            for (const auto& field : plan) {
+                extent = std::max(extent, field.offset + field.size);
+            }
+            return extent;
+        }
+
+        bool check_fields(std::span<const group_field> fields, const std::byte* group) {
+            return std::ranges::all_of(fields, [group](const group_field& field) {
+                return field.check(group + field.offset);
+            });
+        }
+
+        // "min..max", in either order
+        std::optional<std::vector<std::byte>> parse_between(const std::string& input, scan_data_type type) {
+            const auto split = input.find("..");
+            if (split == std::string::npos)
+                return std::nullopt;
+
+            const auto lower = scanner::parse_input(input.substr(0, split), type);
+            const auto upper = scanner::parse_input(input.substr(split + 2), type);
+            if (!lower || !upper)
+                return std::nullopt;
+
+            std::vector<std::byte> range;
+            dispatch_scan_type(type, [&]<typename T>() {
+                const T a = read_at<T>(lower->data());
+                const T b = read_at<T>(upper->data());
+                range = pack_range(std::min(a, b), std::max(a, b));
+            });
+            return range;
+        }
+
+        // "value~epsilon", the range saturates instead of wrapping for integers
+        std::optional<std::vector<std::byte>> parse_approx(const std::string& input, scan_data_type type) {
+            const auto split = input.find('~');
+            if (split == std::string::npos)
+                return std::nullopt;
+
+            const auto value = scanner::parse_input(input.substr(0, split), type);
+            const auto epsilon = scanner::parse_input(input.substr(split + 1), type);
+            if (!value || !epsilon)
+                return std::nullopt;
+
+            std::optional<std::vector<std::byte>> range;
+            dispatch_scan_type(type, [&]<typename T>() {
+                const T v = read_at<T>(value->data());
+                const T e = read_at<T>(epsilon->data());
+                if (e >= T{}) {
+                    range = pack_range(saturating_sub(v, e), saturating_add(v, e));
+                }
+            });
+            return range;
+        }
+
+        // a distance from the previous value. a negative one is refused rather than clamped, it would turn within into
+        // unchanged or, read as unsigned, into a bound that holds everything. the sign is checked in the text since
+        // unsigned parsing takes "-5" as a huge number
+        std::optional<std::vector<std::byte>> parse_distance(const std::string& input, scan_data_type type) {
+            const auto first = input.find_first_not_of(" \t");
+            if (first != std::string::npos && input[first] == '-')
+                return std::nullopt;
+
+            auto value = scanner::parse_input(input, type);
+            if (!value)
+                return std::nullopt;
+
+            bool valid = true;
+            dispatch_scan_type(type, [&]<typename T>() {
+                valid = read_at<T>(value->data()) >= T{}; // nan isn't a distance either
+            });
+            if (!valid)
+                return std::nullopt;
+            return value;
+        }
+
+        // the precision comes from the text, "1.5" rounded covers [1.45, 1.55) and truncated [1.5, 1.6). integers
+        // have nothing to round and keep the exact value
+        std::optional<std::vector<std::byte>> parse_precision(
+                const std::string& input, scan_data_type type, bool truncate
+        ) {
+            auto value = scanner::parse_input(input, type);
+            if (!value)
+                return std::nullopt;
+
+            if (type != scan_data_type::f32 && type != scan_data_type::f64) {
+                value->insert(value->end(), value->begin(), value->end());
+                return value;
+            }
+
+            long double v = 0;
+            int exponent = 0;
+            try {
+                v = std::stold(input);
+                if (const auto at = input.find_first_of("eE"); at != std::string::npos) {
+                    exponent = std::stoi(input.substr(at + 1));
+                }
+            } catch (...) {
+                return std::nullopt;
+            }
+
+            int decimals = 0;
+            if (const auto dot = input.find('.'); dot != std::string::npos) {
+                for (auto i = dot + 1; i < input.size() && std::isdigit(static_cast<unsigned char>(input[i])); ++i) {
+                    ++decimals;
+                }
+            }
+            const long double step = std::pow(10.0L, exponent - decimals);
+
+            long double lower = v - step / 2;
+            long double upper = v + step / 2;
+            bool lower_open = false;
+            bool upper_open = true;
+            if (truncate) {
+                // truncation goes towards zero, so negative values own the range below them
+                const bool negative = std::signbit(v);
+                lower = negative ? v - step : v;
+                upper = negative ? v : v + step;
+                lower_open = negative;
+                upper_open = !negative;
+            }
+
+            return type == scan_data_type::f32 ? narrow_range<float>(lower, lower_open, upper, upper_open)
+                                               : narrow_range<double>(lower, lower_open, upper, upper_open);
+        }
+
+        // a decimal or 0x prefixed integer that type holds without wrapping
+        bool fits_integer(std::string_view text, scan_data_type type) {
+            while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+                text.remove_prefix(1);
+            }
+            while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+                text.remove_suffix(1);
+            }
+
+            const bool negative = text.starts_with('-');
+            if (negative || text.starts_with('+')) {
+                text.remove_prefix(1);
+            }
+            int base = 10;
+            if (text.starts_with("0x") || text.starts_with("0X")) {
+                text.remove_prefix(2);
+                base = 16;
+            }
+
+            std::uint64_t magnitude = 0;
+            const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), magnitude, base);
+            if (text.empty() || error != std::errc{} || end != text.data() + text.size())
+                return false;
+
+            bool fits = false;
+            dispatch_scan_type(type, [&]<typename T>() {
+                if constexpr (std::is_integral_v<T>) {
+                    using unsigned_type = std::make_unsigned_t<T>;
+                    if (negative) {
+                        // the magnitude of lowest() is one past max()
+                        fits = magnitude == 0 ||
+                               (std::is_signed_v<T> &&
+                                magnitude - 1 <= static_cast<unsigned_type>(std::numeric_limits<T>::max()));
+                    } else {
+                        fits = magnitude <= static_cast<unsigned_type>(std::numeric_limits<T>::max());
+                    }
+                }
+            });
+            return fits;
+        }
+
+        // the operands for one type of a numeric scan, nothing when that type can't hold the value. integer types
+        // only take values written as integers, "1.5" is left to the float types instead of matching 1
+        std::optional<std::vector<std::byte>> numeric_operands(
+                const std::string& input, scan_data_type type, scan_compare_type compare
+        ) {
+            if (type != scan_data_type::f32 && type != scan_data_type::f64) {
+                std::string_view text = input;
+                std::string_view second;
+                const auto split = compare == scan_compare_type::between ? text.find("..")
+                                 : compare == scan_compare_type::approx  ? text.find('~')
+                                                                         : std::string_view::npos;
+                if (split != std::string_view::npos) {
+                    second = text.substr(split + (compare == scan_compare_type::between ? 2 : 1));
+                    text = text.substr(0, split);
+                }
+                if (!fits_integer(text, type) || (split != std::string_view::npos && !fits_integer(second, type)))
+                    return std::nullopt;
+            }
+            return scanner::parse_input(input, type, compare);
+        }
+
+        // one type a numeric scan looks for, find runs its kernel over a block and writes the offsets it hit
+        struct numeric_lane {
+            scan_data_type type = scan_data_type::i32;
+            std::size_t size = 0;
+            std::size_t align = 1;
+            std::function<std::size_t(std::span<const std::byte>, std::uint32_t*)> find;
+        };
+
+        // a width is looked at as its signed type, or as the unsigned one when only that holds the value. eight bit
+        // types are left out, a byte value matches at every 256th address of random memory and would bury the rest
+        std::vector<numeric_lane> plan_numeric(const scan_config& config) {
+            constexpr std::array widths = {
+                    std::pair(scan_data_type::i16, scan_data_type::u16),
+                    std::pair(scan_data_type::i32, scan_data_type::u32),
+                    std::pair(scan_data_type::i64, scan_data_type::u64),
+                    std::pair(scan_data_type::f32, scan_data_type::f32),
+                    std::pair(scan_data_type::f64, scan_data_type::f64),
+            };
+
+            std::vector<numeric_lane> lanes;
+            for (const auto& [preferred, fallback] : widths) {
+                auto type = preferred;
+                auto operands = numeric_operands(config.value_str, type, config.compare_type);
+                if (!operands && fallback != preferred) {
+                    type = fallback;
+                    operands = numeric_operands(config.value_str, type, config.compare_type);
+                }
+                if (!operands)
+                    continue;
+
+                numeric_lane lane;
+                lane.type = type;
+                lane.size = scanner::type_size(type);
+                lane.align = config.fast_scan ? lane.size : 1;
+
+                dispatch_scan_type(type, [&]<typename T>() {
+                    const T target = read_at<T>(operands->data());
+                    dispatch_compare(config.compare_type, target, bound_of<T>(*operands), [&](auto matcher) {
+                        using matcher_type = decltype(matcher);
+                        if constexpr (matcher_type::src == simd::source::constant) {
+                            lane.find = [matcher, align = lane.align, kernel = simd::select<T>(matcher_type::op)](
+                                                std::span<const std::byte> data, std::uint32_t* out
+                                        ) {
+                                return kernel(data, align, operands_for<T>(matcher, nullptr), out);
+                            };
+                        }
+                    });
+                });
+
+                if (lane.find) {
+                    lanes.push_back(std::move(lane));
+                }
             }
+            return lanes;
         }
     } // namespace
 
-    std::optional<std::vector<std::byte>> scanner::parse_input(const std::string& input, scan_data_type type) {
+    std::optional<std::vector<std::byte>> scanner::parse_input(
+            const std::string& input, scan_data_type type, scan_compare_type compare
+    ) {
+        // numeric scans take the value per type, see numeric_operands
+        if (type == scan_data_type::numeric)
+            return std::nullopt;
+
+        // byte patterns can be written as well as searched for, as long as they pin every bit. groups are written
+        // as raw bytes too
+        if (type == scan_data_type::bytes || type == scan_data_type::group) {
+            const auto pattern = byte_pattern::parse(input);
+            if (!pattern || pattern->has_wildcards())
+                return std::nullopt;
+            return std::vector(pattern->bytes().begin(), pattern->bytes().end());
+        }
+
+        switch (compare) {
+            case scan_compare_type::between:
+                return parse_between(input, type);
+            case scan_compare_type::approx:
+                return parse_approx(input, type);
+            case scan_compare_type::increased_by:
+            case scan_compare_type::decreased_by:
+            case scan_compare_type::within:
+                return parse_distance(input, type);
+            case scan_compare_type::rounded:
+            case scan_compare_type::truncated:
+                return parse_precision(input, type, compare == scan_compare_type::truncated);
+            default:
+                break;
+        }
+
         std::vector<std::byte> buffer(scanner::type_size(type));
 
         try {
@@ -135,115 +854,638 @@ namespace core {
 
     void scanner::reset() {
         cancel();
+        stream.clear();
         std::lock_guard lock(results_mutex);
         results.clear();
+        baseline.reset();
+        results_generation.reset();
+    }
+
+    void scanner::wait() {
+        scanning.wait(true);
+    }
+
+    void scanner::keep_results(std::span<const std::uint8_t> keep) {
+        std::lock_guard lock(results_mutex);
+        if (scanning || baseline || keep.size() != results.size())
+            return;
+
+        // segments stay as they are apart from the hits they lose, so their order and tags carry over
+        result_store kept(results.memory_budget());
+        std::vector<std::uintptr_t> addresses;
+        std::vector<std::byte> values;
+        std::vector<std::uint32_t> offsets;
+        std::vector<std::byte> kept_values;
+        for (const auto& seg : results.segments()) {
+            addresses.resize(seg.count);
+            values.resize(static_cast<std::size_t>(seg.count) * seg.value_size);
+            results.read(seg.first_index, addresses, values, seg.value_size);
+
+            offsets.clear();
+            kept_values.clear();
+            std::uintptr_t base = 0;
+            for (std::size_t i = 0; i < seg.count; ++i) {
+                if (!keep[seg.first_index + i])
+                    continue;
+                if (offsets.empty()) {
+                    base = addresses[i];
+                }
+                offsets.push_back(static_cast<std::uint32_t>(addresses[i] - base));
+                const auto value = std::span(values).subspan(i * seg.value_size, seg.value_size);
+                kept_values.insert(kept_values.end(), value.begin(), value.end());
+            }
+            if (!offsets.empty()) {
+                kept.push(kept.encode(base, seg.align, offsets, kept_values, seg.tag));
+            }
+        }
+
+        results = std::move(kept);
+        results_generation.reset();
+    }
+
+    std::expected<void, error_code>
+    scanner::save_session(const std::filesystem::path& path, const scan_config& config) const {
+        if (!active_target)
+            return std::unexpected(error_code::not_supported);
+
+        std::lock_guard lock(results_mutex);
+        return core::save_session(path, *active_target, config, results, baseline ? &*baseline : nullptr);
+    }
+
+    std::expected<scan_config, error_code> scanner::load_session(const std::filesystem::path& path) {
+        if (!active_target)
+            return std::unexpected(error_code::not_supported);
+
+        cancel();
+        stream.clear();
+        auto session = core::load_session(path, *active_target);
+        if (!session)
+            return std::unexpected(session.error());
+
+        std::lock_guard lock(results_mutex);
+        results = std::move(session->results);
+        baseline = std::move(session->baseline);
+        results_generation.reset();
+        return session->config;
     }
 
     void scanner::begin_first_scan(const scan_config& config) {
+        // a snapshot is read as one type, so numeric scans need a value to start from
+        if (is_relative(config.compare_type) ||
+            (config.data_type == scan_data_type::numeric && config.compare_type == scan_compare_type::unknown))
+            return;
+
         cancel();
+        stream.clear();
         scanning = true;
         cancel_req = false;
 
         scan_thread = std::jthread([this, config] {
-            worker_scan_first(config);
+            // the pool runs the scan's tasks wherever this thread is pinned
+            if (active_target) {
+                pin_current_thread(active_target->budget().cpus());
+            }
+            if (config.data_type == scan_data_type::bytes) {
+                worker_scan_pattern(config);
+            } else if (config.data_type == scan_data_type::group) {
+                worker_scan_group(config);
+            } else if (config.data_type == scan_data_type::numeric) {
+                worker_scan_numeric(config);
+            } else if (config.compare_type == scan_compare_type::unknown) {
+                worker_scan_unknown(config);
+            } else {
+                worker_scan_first(config);
+            }
+            scanning.notify_all();
         });
     }
 
     void scanner::begin_next_scan(const scan_config& config) {
-        if (results.empty())
+        if ((results.empty() && !baseline) || config.compare_type == scan_compare_type::unknown ||
+            config.data_type == scan_data_type::bytes || (config.data_type == scan_data_type::numeric && baseline))
             return;
 
         cancel();
+        stream.clear();
         scanning = true;
         cancel_req = false;
 
         scan_thread = std::jthread([this, config] {
-            worker_scan_next(config);
+            // the pool runs the scan's tasks wherever this thread is pinned
+            if (active_target) {
+                pin_current_thread(active_target->budget().cpus());
+            }
+            if (config.data_type == scan_data_type::group) {
+                worker_scan_group_next(config);
+            } else if (baseline) {
+                worker_scan_snapshot(config);
+            } else {
+                worker_scan_next(config);
+            }
+            scanning.notify_all();
         });
     }
 
-    void scanner::worker_scan_first(scan_config config) {
-        if (!active_target) {
-            scanning = false;
-            return;
-        }
+    std::expected<void, error_code> scanner::read_target(std::uintptr_t address, std::span<std::byte> buffer) {
+        if (!active_target->budget().acquire(buffer.size(), 1, cancel_req))
+            return std::unexpected(error_code::read_failed);
+        return active_target->read_memory(address, buffer);
+    }
 
-        auto regions_exp = active_target->get_memory_regions();
-        if (!regions_exp) {
-            scanning = false;
-            return;
+    std::size_t scanner::read_target_batch(std::span<const read_request> requests, std::span<std::uint8_t> readable) {
+        std::size_t bytes = 0;
+        for (const auto& r : requests) {
+            bytes += r.buffer.size();
         }
+        if (!active_target->budget().acquire(bytes, active_target->batch_calls(requests.size()), cancel_req)) {
+            std::ranges::fill(readable, std::uint8_t{0});
+            return 0;
+        }
+        return active_target->read_memory_batch(requests, readable);
+    }
 
-        auto regions = *regions_exp;
-        total_scan_bytes = 0;
+    std::span<const std::byte> scanner::fetch(std::uintptr_t address, std::span<std::byte> buffer) {
+        if (auto lent = active_target->view_memory(address, buffer.size()))
+            return *lent;
+        if (!read_target(address, buffer))
+            return {};
+        return buffer;
+    }
 
-        // only writable regions
-        std::erase_if(regions, [](const auto& r) {
-            return r.permission.find('w') == std::string::npos;
-        });
+    std::optional<std::vector<memory_region>> scanner::scan_regions(bool executable) {
+        if (!active_target)
+            return std::nullopt;
+
+        auto table = active_target->get_region_table();
+        if (!table)
+            return std::nullopt;
+
+        // only writable regions, plus executable ones if asked. the rest are never spelled out
+        std::vector<memory_region> regions;
+        for (const auto& e : (*table)->entries()) {
+            if (e.has(perm::write) || (executable && e.has(perm::exec))) {
+                regions.push_back((*table)->region(e));
+            }
+        }
+        total_scan_bytes = 0;
 
+        // every region is read front to back once
         for (const auto& r : regions) {
             total_scan_bytes += r.size;
+            active_target->advise(r.base_address, r.size, access_pattern::sequential);
+        }
+        return regions;
+    }
+
+    void scanner::advance_progress(std::size_t bytes) {
+        const std::size_t done = bytes_scanned.fetch_add(bytes) + bytes;
+        if (total_scan_bytes > 0) {
+            progress_val = static_cast<float>(done) / static_cast<float>(total_scan_bytes);
+        }
+    }
+
+    void scanner::chunk_runs(
+            std::uintptr_t address, std::size_t size, std::size_t own, bool resident_only,
+            std::vector<memory_run>& runs
+    ) {
+        if (!resident_only) {
+            runs.assign(1, {address, size});
+            return;
+        }
+
+        resident_runs(*active_target, address, size, runs);
+        std::size_t kept = 0;
+        for (const auto& run : runs) {
+            kept += std::min(run.address + run.size, address + own) - std::min(run.address, address + own);
         }
+        bytes_skipped += own - kept;
+    }
 
-        auto target_bytes = parse_input(config.value_str, config.data_type);
-        if (!target_bytes) {
+    void scanner::worker_scan_first(scan_config config) {
+        auto regions = scan_regions();
+        auto target_bytes = parse_input(config.value_str, config.data_type, config.compare_type);
+        if (!regions || !target_bytes) {
             scanning = false;
             return;
         }
 
+        const auto generation = active_target->sync_dirty();
+
+        const auto tasks = split_tasks(*regions, [](const memory_region& r) {
+            return std::pair(r.base_address, r.size);
+        });
+
         dispatch_scan_type(config.data_type, [&]<typename T>() {
             const T target_val = read_at<T>(target_bytes->data());
+            const T bound_val = bound_of<T>(*target_bytes);
             std::size_t align = config.fast_scan ? type_size(config.data_type) : 1;
-            const std::size_t chunk_size = 1024 * 1024; // 1mb chunks
 
-            std::vector<scan_result> local_results;
-            local_results.reserve(100000);
-            std::vector<std::byte> buffer(chunk_size);
+            auto& pool = thread_pool::shared();
+            std::vector<scan_buffers> buffers(pool.size());
+            result_store store(config.memory_budget);
+            std::vector<std::vector<result_store::segment>> shards(tasks.size());
 
             bytes_scanned = 0;
+            bytes_skipped = 0;
 
-            auto run_pass = [&](auto matcher) {
-                for (const auto& r : regions) {
-                    if (cancel_req)
-                        break;
+            dispatch_compare(config.compare_type, target_val, bound_val, [&](auto matcher) {
+                // nothing to be relative to on a first scan
+                if constexpr (decltype(matcher)::src == simd::source::constant) {
+                    pool.parallel_for(tasks.size(), [&](std::size_t task_idx, std::size_t worker) {
+                        auto& scratch = buffers[worker];
+                        if (scratch.buffer.empty()) {
+                            scratch.buffer.resize(chunk_size);
+                            scratch.hits.resize(chunk_size / align + 1);
+                        }
 
-                    std::uintptr_t current = r.base_address;
-                    std::size_t remaining = r.size;
+                        std::uintptr_t current = tasks[task_idx].base;
+                        std::size_t remaining = tasks[task_idx].size;
 
-                    while (remaining > 0 && !cancel_req) {
-                        std::size_t read_size = std::min(remaining, chunk_size);
-                        std::span<std::byte> view(buffer.data(), read_size);
+                        while (remaining > 0 && !cancel_req) {
+                            std::size_t read_size = std::min(remaining, chunk_size);
+                            std::span<std::byte> view(scratch.buffer.data(), read_size);
 
-                        if (active_target->read_memory(current, view)) {
-                            scan_region<T>(current, view, matcher, local_results, align);
+                            chunk_runs(current, read_size, read_size, config.resident_only, scratch.runs);
+                            for (const auto& run : scratch.runs) {
+                                const auto piece = fetch(run.address, view.subspan(run.address - current, run.size));
+                                if (!piece.empty()) {
+                                    scan_region<T>(
+                                            run.address, piece, matcher, store, shards[task_idx], scratch, align
+                                    );
+                                }
+                            }
+
+                            current += read_size;
+                            remaining -= read_size;
+                            advance_progress(read_size);
                         }
+                    });
+                }
+            });
 
-                        current += read_size;
-                        remaining -= read_size;
-                        bytes_scanned += read_size;
+            for (const auto& shard : shards) {
+                for (const auto& seg : shard) {
+                    store.push(seg);
+                }
+            }
+
+            std::lock_guard lock(results_mutex);
+            results = std::move(store);
+            baseline.reset();
+            results_generation = generation;
+        });
 
-                        if (total_scan_bytes > 0) {
-                            progress_val = static_cast<float>(bytes_scanned) / static_cast<float>(total_scan_bytes);
+        scanning = false;
+        progress_val = 1.0f;
+    }
+
+    void scanner::worker_scan_numeric(scan_config config) {
+        auto regions = scan_regions();
+        const auto lanes = plan_numeric(config);
+        if (!regions || lanes.empty()) {
+            scanning = false;
+            return;
+        }
+
+        const auto generation = active_target->sync_dirty();
+
+        const auto tasks = split_tasks(*regions, [](const memory_region& r) {
+            return std::pair(r.base_address, r.size);
+        });
+
+        auto& pool = thread_pool::shared();
+        std::vector<scan_buffers> buffers(pool.size());
+        result_store store(config.memory_budget);
+        // per type, then per task, so the results come out grouped by type and in address order within each
+        std::vector<std::vector<std::vector<result_store::segment>>> shards(
+                lanes.size(), std::vector<std::vector<result_store::segment>>(tasks.size())
+        );
+
+        bytes_scanned = 0;
+        bytes_skipped = 0;
+
+        pool.parallel_for(tasks.size(), [&](std::size_t task_idx, std::size_t worker) {
+            auto& scratch = buffers[worker];
+            if (scratch.buffer.empty()) {
+                scratch.buffer.resize(chunk_size);
+                scratch.hits.resize(block_size + sizeof(std::uint64_t));
+                scratch.typed_hits.resize(lanes.size());
+            }
+
+            std::uintptr_t current = tasks[task_idx].base;
+            std::size_t remaining = tasks[task_idx].size;
+
+            while (remaining > 0 && !cancel_req) {
+                const std::size_t read_size = std::min(remaining, chunk_size);
+                std::span<std::byte> view(scratch.buffer.data(), read_size);
+
+                chunk_runs(current, read_size, read_size, config.resident_only, scratch.runs);
+                for (const auto& run : scratch.runs) {
+                    const auto piece = fetch(run.address, view.subspan(run.address - current, run.size));
+                    if (piece.empty())
+                        continue;
+
+                    // every type goes over a block while it is still in cache, so memory is read once however many
+                    // types there are. a block is seen as far into the next one as a value starting in it reaches
+                    for (auto& hits : scratch.typed_hits) {
+                        hits.clear();
+                    }
+                    for (std::size_t at = 0; at < piece.size(); at += block_size) {
+                        const std::size_t own = std::min(block_size, piece.size() - at);
+                        for (std::size_t l = 0; l < lanes.size(); ++l) {
+                            const auto& lane = lanes[l];
+                            const auto block = piece.subspan(at, std::min(own + lane.size - 1, piece.size() - at));
+                            if (block.size() < lane.size)
+                                continue;
+
+                            const std::size_t count = lane.find(block, scratch.hits.data());
+                            auto& hits = scratch.typed_hits[l];
+                            for (std::size_t i = 0; i < count && scratch.hits[i] < own; ++i) {
+                                hits.push_back(static_cast<std::uint32_t>(at + scratch.hits[i]));
+                            }
                         }
                     }
+
+                    for (std::size_t l = 0; l < lanes.size(); ++l) {
+                        const auto& hits = scratch.typed_hits[l];
+                        if (hits.empty())
+                            continue;
+
+                        const std::size_t size = lanes[l].size;
+                        scratch.values.resize(hits.size() * size);
+                        for (std::size_t i = 0; i < hits.size(); ++i) {
+                            std::memcpy(scratch.values.data() + i * size, piece.data() + hits[i], size);
+                        }
+
+                        shards[l][task_idx].push_back(store.encode(
+                                run.address, lanes[l].align, hits, scratch.values, type_tag(lanes[l].type)
+                        ));
+                        stream.append(scratch.live, run.address, hits);
+                    }
                 }
-            };
 
-            switch (config.compare_type) {
-                case scan_compare_type::exact:
-                    run_pass(exact_matcher(target_val));
-                    break;
-                case scan_compare_type::greater:
-                    run_pass(greater_matcher(target_val));
-                    break;
-                case scan_compare_type::less:
-                    run_pass(less_matcher(target_val));
-                    break;
+                current += read_size;
+                remaining -= read_size;
+                advance_progress(read_size);
+            }
+        });
+
+        for (const auto& lane : shards) {
+            for (const auto& shard : lane) {
+                for (const auto& seg : shard) {
+                    store.push(seg);
+                }
+            }
+        }
+
+        {
+            std::lock_guard lock(results_mutex);
+            results = std::move(store);
+            baseline.reset();
+            results_generation = generation;
+        }
+
+        scanning = false;
+        progress_val = 1.0f;
+    }
+
+    void scanner::worker_scan_unknown(scan_config config) {
+        auto regions = scan_regions();
+        if (!regions) {
+            scanning = false;
+            return;
+        }
+
+        const auto generation = active_target->sync_dirty();
+        const std::size_t align = config.fast_scan ? type_size(config.data_type) : 1;
+        snapshot snap(align);
+        for (const auto& r : *regions) {
+            snap.add_region(r.base_address, r.size);
+        }
+
+        const auto tasks = split_tasks(*regions, [](const memory_region& r) {
+            return std::pair(r.base_address, r.size);
+        });
+
+        auto& pool = thread_pool::shared();
+        std::vector<scan_buffers> buffers(pool.size());
+        bytes_scanned = 0;
+        bytes_skipped = 0;
+
+        pool.parallel_for(tasks.size(), [&](std::size_t task_idx, std::size_t worker) {
+            auto& scratch = buffers[worker];
+            if (scratch.buffer.empty()) {
+                scratch.buffer.resize(chunk_size);
+            }
+
+            const auto& task = tasks[task_idx];
+            auto& region = snap.regions()[task.region];
+
+            for (std::size_t offset = 0; offset < task.size && !cancel_req; offset += chunk_size) {
+                const std::uintptr_t current = task.base + offset;
+                const std::size_t read_size = std::min(chunk_size, task.size - offset);
+
+                // unreadable and skipped pages stay uncopied, so later passes never consider them
+                chunk_runs(current, read_size, read_size, config.resident_only, scratch.runs);
+                for (const auto& run : scratch.runs) {
+                    const auto view = fetch(run.address, std::span(scratch.buffer.data(), run.size));
+                    if (view.empty())
+                        continue;
+
+                    const std::size_t first_page = (run.address - region.base) / snapshot::page_size;
+                    std::size_t slots = 0;
+
+                    for (std::size_t at = 0; at < run.size; at += snapshot::page_size) {
+                        const auto bytes = view.subspan(at, std::min(snapshot::page_size, run.size - at));
+                        auto& page = region.pages[first_page + at / snapshot::page_size];
+                        page.data = snap.store_data(bytes);
+                        page.mask = snapshot::all;
+                        slots += bytes.size() / align;
+                    }
+                    snap.add_candidates(slots);
+                }
+
+                advance_progress(read_size);
             }
+        });
 
+        {
             std::lock_guard lock(results_mutex);
-            results = std::move(local_results);
+            results.clear();
+            baseline = std::move(snap);
+            results_generation = generation;
+        }
+
+        scanning = false;
+        progress_val = 1.0f;
+    }
+
+    void scanner::worker_scan_snapshot(scan_config config) {
+        std::optional<std::vector<std::byte>> target_bytes;
+        if (needs_value(config.compare_type)) {
+            target_bytes = parse_input(config.value_str, config.data_type, config.compare_type);
+            if (!target_bytes) {
+                scanning = false;
+                return;
+            }
+        }
+
+        // only this thread ever replaces the baseline, so reading it without the lock is fine
+        const snapshot& prev = *baseline;
+        const std::size_t align = prev.align();
+        const auto since = results_generation;
+        const auto generation = active_target->sync_dirty();
+
+        snapshot next(align);
+        total_scan_bytes = 0;
+        for (const auto& r : prev.regions()) {
+            next.add_region(r.base, r.size);
+            total_scan_bytes += r.size;
+        }
+
+        const auto tasks = split_tasks(prev.regions(), [](const snapshot::region& r) {
+            return std::pair(r.base, r.size);
+        });
+
+        dispatch_scan_type(config.data_type, [&]<typename T>() {
+            const T target_val = target_bytes ? read_at<T>(target_bytes->data()) : T{};
+            const T bound_val = target_bytes ? bound_of<T>(*target_bytes) : T{};
+
+            auto& pool = thread_pool::shared();
+            std::vector<scan_buffers> buffers(pool.size());
+            bytes_scanned = 0;
+
+            dispatch_compare(config.compare_type, target_val, bound_val, [&](auto matcher) {
+                using matcher_type = decltype(matcher);
+                const auto kernel = simd::select<T>(matcher_type::op, matcher_type::src);
+
+                pool.parallel_for(tasks.size(), [&](std::size_t task_idx, std::size_t worker) {
+                    auto& scratch = buffers[worker];
+                    if (scratch.buffer.empty()) {
+                        scratch.buffer.resize(chunk_size);
+                        scratch.previous.resize(chunk_size);
+                        scratch.hits.resize(chunk_size / align + 1);
+                        scratch.mask.resize(next.mask_words());
+                    }
+
+                    const auto& task = tasks[task_idx];
+                    const auto& old_region = prev.regions()[task.region];
+                    auto& new_region = next.regions()[task.region];
+
+                    for (std::size_t offset = 0; offset < task.size && !cancel_req; offset += chunk_size) {
+                        const std::uintptr_t current = task.base + offset;
+                        const std::size_t read_size = std::min(chunk_size, task.size - offset);
+                        const std::size_t first_page = (current - old_region.base) / snapshot::page_size;
+                        const std::size_t page_count = (read_size + snapshot::page_size - 1) / snapshot::page_size;
+                        const auto pages = std::span(old_region.pages).subspan(first_page, page_count);
+
+                        // chunks without candidates left aren't even read
+                        const bool live = std::ranges::any_of(pages, [](const snapshot::page& p) {
+                            return p.mask != snapshot::none;
+                        });
+
+                        const std::span<std::byte> buffer(scratch.buffer.data(), read_size);
+                        std::span<const std::byte> view;
+                        if (live && since) {
+                            if (read_written(*active_target, current, buffer, prev, pages, *since, scratch.requests,
+                                             cancel_req)) {
+                                view = buffer;
+                            }
+                        } else if (live) {
+                            view = fetch(current, buffer);
+                        }
+                        if (!view.empty()) {
+                            if constexpr (matcher_type::src == simd::source::previous) {
+                                for (std::size_t i = 0; i < page_count; ++i) {
+                                    const std::size_t at = i * snapshot::page_size;
+                                    const std::size_t size = std::min(snapshot::page_size, read_size - at);
+                                    if (pages[i].data != snapshot::none) {
+                                        std::memcpy(scratch.previous.data() + at, prev.data(pages[i].data), size);
+                                    } else {
+                                        std::memset(scratch.previous.data() + at, 0, size);
+                                    }
+                                }
+                            }
+
+                            std::size_t count = 0;
+                            if constexpr (requires { matcher.lower(T{}); }) {
+                                // unaligned slots overlap, so a derived right hand side can't be laid out as one
+                                // buffer. these modes check the remaining candidates one by one instead
+                                for (std::size_t i = 0; i < page_count; ++i) {
+                                    if (pages[i].mask == snapshot::none)
+                                        continue;
+
+                                    const std::size_t at = i * snapshot::page_size;
+                                    for (std::size_t in_page = 0; in_page < snapshot::page_size; in_page += align) {
+                                        if (at + in_page + sizeof(T) > read_size)
+                                            break;
+                                        if (prev.is_candidate(pages[i], in_page) &&
+                                            matcher(read_at<T>(view.data() + at + in_page),
+                                                    read_at<T>(scratch.previous.data() + at + in_page))) {
+                                            scratch.hits[count++] = static_cast<std::uint32_t>(at + in_page);
+                                        }
+                                    }
+                                }
+                            } else {
+                                count = kernel(
+                                        view, align, operands_for<T>(matcher, scratch.previous.data()),
+                                        scratch.hits.data()
+                                );
+                            }
+
+                            // hits come sorted, so they fold into the per page masks in one walk
+                            std::size_t hit = 0;
+                            std::size_t found = 0;
+                            std::size_t kept_before = 0;
+                            for (std::size_t i = 0; i < page_count; ++i) {
+                                const std::size_t at = i * snapshot::page_size;
+                                std::ranges::fill(scratch.mask, 0);
+
+                                std::size_t kept = 0;
+                                for (; hit < count && scratch.hits[hit] < at + snapshot::page_size; ++hit) {
+                                    const std::size_t in_page = scratch.hits[hit] - at;
+                                    if (prev.is_candidate(pages[i], in_page)) {
+                                        const std::size_t slot = in_page / align;
+                                        scratch.mask[slot / 64] |= std::uint64_t{1} << (slot % 64);
+                                        ++kept;
+                                    }
+                                }
+
+                                auto& page = new_region.pages[first_page + i];
+                                if (kept > 0) {
+                                    page.mask = next.store_mask(scratch.mask);
+                                }
+                                // a value at the end of the previous page reads into this one
+                                if (kept > 0 || kept_before > 0) {
+                                    page.data = next.store_data(
+                                            view.subspan(at, std::min(snapshot::page_size, read_size - at))
+                                    );
+                                }
+
+                                kept_before = kept;
+                                found += kept;
+                            }
+                            next.add_candidates(found);
+                        }
+
+                        advance_progress(read_size);
+                    }
+                });
+            });
+
+            // a cancelled pass leaves the previous snapshot in place
+            if (cancel_req)
+                return;
+
+            std::lock_guard lock(results_mutex);
+            if (next.candidate_count() < config.materialize_threshold) {
+                results = materialize<T>(next, config.memory_budget);
+                baseline.reset();
+            } else {
+                results.clear();
+                baseline = std::move(next);
+            }
+            results_generation = generation;
         });
 
         scanning = false;
@@ -251,55 +1493,497 @@ namespace core {
     }
 
     void scanner::worker_scan_next(scan_config config) {
-        auto target_bytes = parse_input(config.value_str, config.data_type);
-        if (!target_bytes || results.empty()) {
+        const bool numeric = config.data_type == scan_data_type::numeric;
+        const bool wants_value = needs_value(config.compare_type);
+        auto operands_as = [&](scan_data_type type) {
+            return numeric ? numeric_operands(config.value_str, type, config.compare_type)
+                           : parse_input(config.value_str, type, config.compare_type);
+        };
+
+        // a value that isn't a number leaves the results as they are. one that only some of the types of a numeric
+        // scan hold drops the results of the others
+        if ((wants_value && !operands_as(numeric ? scan_data_type::f64 : config.data_type)) || results.empty()) {
             scanning = false;
             return;
         }
 
-        dispatch_scan_type(config.data_type, [&]<typename T>() {
-            const T target_val = read_at<T>(target_bytes->data());
+        const auto since = results_generation;
+        const auto generation = active_target->sync_dirty();
+
+        result_store next_results(config.memory_budget);
+        result_stream::cursor live;
+        const std::size_t total = results.size();
+        const auto segments = results.segments();
+
+        // numeric results come grouped by type and each group goes through with the matcher for its own type,
+        // results of any other scan are all taken as the configured type
+        for (std::size_t group = 0; group < segments.size() && !cancel_req;) {
+            std::size_t group_end = numeric ? group + 1 : segments.size();
+            while (group_end < segments.size() && segments[group_end].tag == segments[group].tag) {
+                ++group_end;
+            }
+
+            const auto type = numeric ? tagged_type(segments[group].tag) : std::optional(config.data_type);
+            std::optional<std::vector<std::byte>> target_bytes;
+            if (type && wants_value) {
+                target_bytes = operands_as(*type);
+            }
+            if (!type || (wants_value && !target_bytes)) {
+                group = group_end;
+                continue;
+            }
+
+            dispatch_scan_type(*type, [&]<typename T>() {
+                const T target_val = target_bytes ? read_at<T>(target_bytes->data()) : T{};
+                const T bound_val = target_bytes ? bound_of<T>(*target_bytes) : T{};
+
+                // values stored at another width come back zeroed, so the memory behind them is read again even
+                // where nothing wrote to it
+                const bool values_kept = std::ranges::all_of(
+                        segments.subspan(group, group_end - group), [](const result_store::segment& seg) {
+                            return seg.value_size == sizeof(T);
+                        }
+                );
+                const auto clean_since = values_kept ? since : std::nullopt;
+
+                // candidates sharing a page are fetched as one range, and each batch of ranges goes to the
+                // target at once so live backends can put many of them into a single syscall
+                struct read_range {
+                    std::size_t first;
+                    std::size_t last;
+                    std::size_t offset;
+                    bool readable;
+                    bool clean; // nothing wrote to it since the last pass, the values read then still hold
+                };
+
+                const std::size_t max_ranges = 1024;
+                const std::size_t window_size = 64 * 1024;
+                std::vector<read_range> ranges;
+                std::vector<read_request> requests;
+                std::vector<std::size_t> requested;
+                std::vector<std::uint8_t> delivered(max_ranges);
+                std::vector<std::byte> bulk;
+                std::vector<std::byte> buf(sizeof(T));
+                std::vector<std::uint32_t> offsets;
+
+                // one window of candidates as parallel arrays, addresses and the values read before and now, so the
+                // compare itself is one kernel call over contiguous memory
+                std::vector<std::uintptr_t> window(window_size);
+                std::vector<T> previous(window_size);
+                std::vector<T> current(window_size);
+                std::vector<std::uint8_t> readable(window_size);
+                std::vector<T> lower(window_size);
+                std::vector<T> upper(window_size);
+                std::vector<std::uint32_t> hits(window_size + 1);
 
-            std::vector<scan_result> next_results;
-            next_results.reserve(results.size());
+                std::vector<std::uintptr_t> survivors;
+                std::vector<T> survivor_values;
 
-            std::vector<std::byte> buf(sizeof(T));
-            std::size_t processed = 0;
-            const std::size_t total = results.size();
+                // survivors are re-encoded against the segment they came from once the scan has moved past it
+                std::size_t seg_idx = group;
+                std::size_t survivor_pos = 0;
+                auto flush_segments = [&](std::size_t done) {
+                    for (; seg_idx < group_end && segments[seg_idx].first_index + segments[seg_idx].count <= done;
+                         ++seg_idx) {
+                        const auto& seg = segments[seg_idx];
+                        const std::size_t first = survivor_pos;
+                        offsets.clear();
+                        while (survivor_pos < survivors.size() && survivors[survivor_pos] - seg.base <= seg.extent) {
+                            offsets.push_back(static_cast<std::uint32_t>(survivors[survivor_pos++] - seg.base));
+                        }
+
+                        const auto values =
+                                std::as_bytes(std::span(survivor_values).subspan(first, survivor_pos - first));
+                        next_results.push(
+                                next_results.encode(seg.base, seg.align, offsets, values, numeric ? seg.tag : 0)
+                        );
+                        stream.append(live, seg.base, offsets);
+                    }
+
+                    if (survivor_pos == survivors.size()) {
+                        survivors.clear();
+                        survivor_values.clear();
+                        survivor_pos = 0;
+                    }
+                };
+
+                auto filter_pass = [&](auto matcher) {
+                    using matcher_type = decltype(matcher);
+                    const auto kernel = simd::select<T>(matcher_type::op, matcher_type::src);
+
+                    std::size_t consumed = segments[group].first_index;
+                    const std::size_t until = segments[group_end - 1].first_index + segments[group_end - 1].count;
+                    while (consumed < until && !cancel_req) {
+                        const std::size_t want = std::min(window_size, until - consumed);
+                        const std::size_t count = results.read(
+                                consumed, std::span(window).first(want),
+                                std::as_writable_bytes(std::span(previous).first(want)), sizeof(T)
+                        );
+                        const std::span<const std::uintptr_t> addresses(window.data(), count);
+
+                        std::size_t index = 0;
+                        while (index < count && !cancel_req) {
+                            ranges.clear();
+                            requests.clear();
+                            requested.clear();
+
+                            std::size_t bytes = 0;
+                            while (index < count && ranges.size() < max_ranges) {
+                                const std::uintptr_t start = addresses[index];
+                                std::size_t end = index + 1;
+                                while (end < count && addresses[end] >= addresses[end - 1] &&
+                                       addresses[end] / page_size == start / page_size) {
+                                    ++end;
+                                }
+
+                                const std::size_t length = addresses[end - 1] + sizeof(T) - start;
+                                const bool clean =
+                                        clean_since && !active_target->written_since(start, length, *clean_since);
+                                ranges.push_back({index, end, bytes, true, clean});
+                                if (!clean) {
+                                    bytes += length;
+                                }
+                                index = end;
+                            }
+
+                            bulk.resize(bytes);
+                            for (std::size_t i = 0; i < ranges.size(); ++i) {
+                                const auto& range = ranges[i];
+                                if (range.clean)
+                                    continue;
+
+                                const std::uintptr_t start = addresses[range.first];
+                                const std::size_t length = addresses[range.last - 1] + sizeof(T) - start;
+                                requests.push_back({start, std::span(bulk.data() + range.offset, length)});
+                                requested.push_back(i);
+                            }
+
+                            // a range that fails is retried address by address below, so a value next to an unmapped
+                            // page still gets the same answer as an individual read
+                            read_target_batch(requests, std::span(delivered).first(requests.size()));
+                            for (std::size_t r = 0; r < requests.size(); ++r) {
+                                ranges[requested[r]].readable = delivered[r];
+                            }
+
+                            for (const auto& range : ranges) {
+                                const std::uintptr_t start = addresses[range.first];
+                                for (std::size_t i = range.first; i < range.last; ++i) {
+                                    const std::uintptr_t address = addresses[i];
+
+                                    readable[i] = 1;
+                                    if (range.clean) {
+                                        current[i] = previous[i];
+                                    } else if (range.readable) {
+                                        current[i] = read_at<T>(bulk.data() + range.offset + (address - start));
+                                    } else if (read_target(address, buf)) {
+                                        current[i] = read_at<T>(buf.data());
+                                    } else {
+                                        current[i] = T{};
+                                        readable[i] = 0;
+                                    }
+                                }
+                            }
+
+                            progress_val = static_cast<float>(consumed + index) / static_cast<float>(total);
+                        }
+
+                        // modes like increased by n compare against a value derived from the previous one, those
+                        // get mapped into their own arrays first
+                        const std::byte* rhs = reinterpret_cast<const std::byte*>(previous.data());
+                        const std::byte* rhs_upper = nullptr;
+                        if constexpr (requires { matcher.lower(T{}); }) {
+                            for (std::size_t i = 0; i < index; ++i) {
+                                lower[i] = matcher.lower(previous[i]);
+                            }
+                            rhs = reinterpret_cast<const std::byte*>(lower.data());
+                        }
+                        if constexpr (requires { matcher.upper(T{}); }) {
+                            for (std::size_t i = 0; i < index; ++i) {
+                                upper[i] = matcher.upper(previous[i]);
+                            }
+                            rhs_upper = reinterpret_cast<const std::byte*>(upper.data());
+                        }
+
+                        const std::size_t found = kernel(
+                                std::as_bytes(std::span(current.data(), index)), sizeof(T),
+                                operands_for<T>(matcher, rhs, rhs_upper), hits.data()
+                        );
+
+                        for (std::size_t h = 0; h < found; ++h) {
+                            const std::size_t i = hits[h] / sizeof(T);
+                            if (readable[i]) {
+                                survivors.push_back(addresses[i]);
+                                survivor_values.push_back(current[i]);
+                            }
+                        }
+
+                        consumed += index;
+                        flush_segments(consumed);
+                    }
+                };
+
+                dispatch_compare(config.compare_type, target_val, bound_val, filter_pass);
+            });
+
+            group = group_end;
+        }
+
+        if (!cancel_req) {
+            std::lock_guard lock(results_mutex);
+            results = std::move(next_results);
+            results_generation = generation;
+        }
+
+        scanning = false;
+        progress_val = 1.0f;
+    }
+
+    void scanner::worker_scan_pattern(scan_config config) {
+        // signatures are as often code as data, so executable regions are searched too
+        auto regions = scan_regions(true);
+        const auto pattern = byte_pattern::parse(config.value_str);
+        if (!regions || !pattern) {
+            scanning = false;
+            return;
+        }
+
+        const auto tasks = split_tasks(*regions, [](const memory_region& r) {
+            return std::pair(r.base_address, r.size);
+        });
+
+        // every chunk is read together with the start of the next one, so a match across the boundary is seen
+        // by the chunk it starts in
+        const std::size_t overlap = pattern->size() - 1;
+
+        auto& pool = thread_pool::shared();
+        std::vector<scan_buffers> buffers(pool.size());
+        result_store store(config.memory_budget);
+        std::vector<std::vector<result_store::segment>> shards(tasks.size());
+        bytes_scanned = 0;
+        bytes_skipped = 0;
+
+        pool.parallel_for(tasks.size(), [&](std::size_t task_idx, std::size_t worker) {
+            auto& scratch = buffers[worker];
+            if (scratch.buffer.empty()) {
+                scratch.buffer.resize(chunk_size + overlap);
+                scratch.hits.resize(chunk_size + overlap + 1);
+            }
+
+            const auto& task = tasks[task_idx];
+            const auto& region = (*regions)[task.region];
+            const std::uintptr_t region_end = region.base_address + region.size;
+
+            for (std::size_t offset = 0; offset < task.size && !cancel_req; offset += chunk_size) {
+                const std::uintptr_t current = task.base + offset;
+                const std::size_t size = std::min(chunk_size, task.size - offset);
+                const std::size_t extent = std::min(size + overlap, region_end - current);
+
+                chunk_runs(current, extent, size, config.resident_only, scratch.runs);
+                for (const auto& run : scratch.runs) {
+                    // runs starting in the overlap are the next chunk's
+                    const std::size_t start = run.address - current;
+                    if (start >= size)
+                        break;
+                    const std::size_t own = size - start;
+                    const auto buffer = std::span(scratch.buffer).subspan(start, run.size);
+
+                    // the overlap can reach a page that isn't readable while the chunk itself is
+                    auto view = fetch(run.address, buffer);
+                    if (view.empty() && buffer.size() > own) {
+                        view = fetch(run.address, buffer.first(own));
+                    }
+                    if (view.empty())
+                        continue;
+
+                    std::size_t count = pattern->find(view, scratch.hits.data());
+                    // matches starting in the overlap are the next chunk's
+                    while (count > 0 && scratch.hits[count - 1] >= own) {
+                        --count;
+                    }
+                    if (count > 0) {
+                        shards[task_idx].push_back(
+                                store.encode(run.address, 1, std::span(scratch.hits.data(), count))
+                        );
+                        stream.append(scratch.live, run.address, std::span(scratch.hits.data(), count));
+                    }
+                }
+
+                advance_progress(size);
+            }
+        });
+
+        for (const auto& shard : shards) {
+            for (const auto& seg : shard) {
+                store.push(seg);
+            }
+        }
+
+        {
+            std::lock_guard lock(results_mutex);
+            results = std::move(store);
+            baseline.reset();
+            results_generation.reset();
+        }
+
+        scanning = false;
+        progress_val = 1.0f;
+    }
+
+    void scanner::worker_scan_group(scan_config config) {
+        auto regions = scan_regions();
+        const auto plan = plan_group(config.fields);
+        if (!regions || !plan) {
+            scanning = false;
+            return;
+        }
+
+        // groups start where their widest field could, and the chunk reads reach into the next chunk far enough to
+        // see every group starting in them, the same way pattern scans do
+        const std::size_t extent = group_extent(*plan);
+        const std::size_t overlap = extent - 1;
+        std::size_t align = 1;
+        if (config.fast_scan) {
+            for (const auto& field : *plan) {
+                align = std::max(align, field.size);
+            }
+        }
+        const auto& lead = plan->front();
+
+        const auto tasks = split_tasks(*regions, [](const memory_region& r) {
+            return std::pair(r.base_address, r.size);
+        });
+
+        auto& pool = thread_pool::shared();
+        std::vector<scan_buffers> buffers(pool.size());
+        result_store store(config.memory_budget);
+        std::vector<std::vector<result_store::segment>> shards(tasks.size());
+        bytes_scanned = 0;
+        bytes_skipped = 0;
 
-            auto filter_pass = [&](auto matcher) {
-                for (const auto& res : results) {
-                    if (cancel_req)
+        pool.parallel_for(tasks.size(), [&](std::size_t task_idx, std::size_t worker) {
+            auto& scratch = buffers[worker];
+            if (scratch.buffer.empty()) {
+                scratch.buffer.resize(chunk_size + overlap);
+                scratch.hits.resize((chunk_size + overlap) / align + 1);
+            }
+
+            const auto& task = tasks[task_idx];
+            const auto& region = (*regions)[task.region];
+            const std::uintptr_t region_end = region.base_address + region.size;
+
+            for (std::size_t offset = 0; offset < task.size && !cancel_req; offset += chunk_size) {
+                const std::uintptr_t current = task.base + offset;
+                const std::size_t size = std::min(chunk_size, task.size - offset);
+                const std::size_t reach = std::min(size + overlap, region_end - current);
+
+                chunk_runs(current, reach, size, config.resident_only, scratch.runs);
+                for (const auto& run : scratch.runs) {
+                    const std::size_t start = run.address - current;
+                    if (start >= size)
                         break;
+                    const std::size_t own = size - start;
+                    const auto buffer = std::span(scratch.buffer).subspan(start, run.size);
 
-                    if (++processed % 1000 == 0) {
-                        progress_val = static_cast<float>(processed) / static_cast<float>(total);
+                    auto view = fetch(run.address, buffer);
+                    if (view.empty() && buffer.size() > own) {
+                        view = fetch(run.address, buffer.first(own));
                     }
+                    if (view.size() < extent)
+                        continue;
+
+                    // the lead field alone goes through the kernel, cut so every hit has its whole group in view
+                    const auto lead_view = view.subspan(lead.offset, view.size() - extent + lead.size);
+                    const std::size_t count = lead.prefilter(lead_view, align, scratch.hits.data());
 
-                    if (active_target->read_memory(res.address, buf)) {
-                        T val = read_at<T>(buf.data());
-                        if (matcher(val)) {
-                            next_results.push_back(res);
+                    std::size_t kept = 0;
+                    for (std::size_t i = 0; i < count && scratch.hits[i] < own; ++i) {
+                        if (check_fields(std::span(*plan).subspan(1), view.data() + scratch.hits[i])) {
+                            scratch.hits[kept++] = scratch.hits[i];
                         }
                     }
+                    if (kept > 0) {
+                        shards[task_idx].push_back(
+                                store.encode(run.address, align, std::span(scratch.hits.data(), kept))
+                        );
+                        stream.append(scratch.live, run.address, std::span(scratch.hits.data(), kept));
+                    }
                 }
-            };
 
-            switch (config.compare_type) {
-                case scan_compare_type::exact:
-                    filter_pass(exact_matcher(target_val));
-                    break;
-                case scan_compare_type::greater:
-                    filter_pass(greater_matcher(target_val));
-                    break;
-                case scan_compare_type::less:
-                    filter_pass(less_matcher(target_val));
-                    break;
+                advance_progress(size);
+            }
+        });
+
+        for (const auto& shard : shards) {
+            for (const auto& seg : shard) {
+                store.push(seg);
+            }
+        }
+
+        {
+            std::lock_guard lock(results_mutex);
+            results = std::move(store);
+            baseline.reset();
+            results_generation.reset();
+        }
+
+        scanning = false;
+        progress_val = 1.0f;
+    }
+
+    void scanner::worker_scan_group_next(scan_config config) {
+        const auto plan = plan_group(config.fields);
+        if (!plan || results.empty()) {
+            scanning = false;
+            return;
+        }
+
+        const std::size_t extent = group_extent(*plan);
+        const std::size_t window_size = 64 * 1024;
+        std::vector<std::uintptr_t> window(window_size);
+        std::vector<std::byte> bulk(window_size * extent);
+        std::vector<read_request> requests;
+        std::vector<std::uint8_t> readable(window_size);
+        std::vector<std::uint32_t> offsets;
+
+        result_store next_results(config.memory_budget);
+        result_stream::cursor live;
+        const std::size_t total = results.size();
+
+        // groups are re-read whole, one request each, and re-encoded against the segment they came from
+        for (const auto& seg : results.segments()) {
+            offsets.clear();
+            for (std::size_t done = 0; done < seg.count && !cancel_req;) {
+                const std::size_t want = std::min<std::size_t>(window_size, seg.count - done);
+                const std::size_t count = results.read(seg.first_index + done, std::span(window).first(want));
+
+                requests.clear();
+                for (std::size_t i = 0; i < count; ++i) {
+                    requests.push_back({window[i], std::span(bulk.data() + i * extent, extent)});
+                }
+                read_target_batch(requests, std::span(readable).first(count));
+
+                for (std::size_t i = 0; i < count; ++i) {
+                    const std::byte* group = bulk.data() + i * extent;
+                    if (readable[i] && check_fields(*plan, group)) {
+                        offsets.push_back(static_cast<std::uint32_t>(window[i] - seg.base));
+                    }
+                }
+
+                done += count;
+                progress_val = static_cast<float>(seg.first_index + done) / static_cast<float>(total);
             }
 
+            if (cancel_req)
+                break;
+            next_results.push(next_results.encode(seg.base, seg.align, offsets));
+            stream.append(live, seg.base, offsets);
+        }
+
+        if (!cancel_req) {
             std::lock_guard lock(results_mutex);
             results = std::move(next_results);
-        });
+            results_generation.reset();
+        }
 
         scanning = false;
         progress_val = 1.0f;
@@ -307,25 +1991,29 @@ namespace core {
 
     template <typename T, typename Predicate>
     void scanner::scan_region(
-            std::uintptr_t base, std::span<const std::byte> buffer, Predicate pred,
-            std::vector<scan_result>& local_results, std::size_t align
+            std::uintptr_t base, std::span<const std::byte> buffer, Predicate pred, result_store& store,
+            std::vector<result_store::segment>& segments, scan_buffers& scratch, std::size_t align
     ) {
         if (buffer.size() < sizeof(T))
             return;
 
-        const std::byte* ptr = buffer.data();
-        const std::byte* end = buffer.data() + buffer.size() - sizeof(T);
+        auto& hits = scratch.hits;
+        hits.resize(std::max(hits.size(), buffer.size() / align + 1));
 
-        for (; ptr <= end; ptr += align) {
-            T val;
-            std::memcpy(&val, ptr, sizeof(T));
-            if (pred(val)) {
-                local_results.push_back({
-                        .address = base + static_cast<std::size_t>(ptr - buffer.data()),
-                        .original_bytes = {} // TODO: only used if we track history
-                });
-            }
+        const auto kernel = simd::select<T>(Predicate::op);
+        const std::size_t count = kernel(buffer, align, operands_for<T>(pred, nullptr), hits.data());
+        if (count == 0)
+            return;
+
+        // keep what every hit read as, relative next scans compare against it
+        auto& values = scratch.values;
+        values.resize(count * sizeof(T));
+        for (std::size_t i = 0; i < count; ++i) {
+            std::memcpy(values.data() + i * sizeof(T), buffer.data() + hits[i], sizeof(T));
         }
+
+        segments.push_back(store.encode(base, align, std::span(hits.data(), count), values));
+        stream.append(scratch.live, base, std::span(hits.data(), count));
     }
 
     std::size_t scanner::type_size(scan_data_type type) {
@@ -344,10 +2032,32 @@ namespace core {
             case scan_data_type::u64:
             case scan_data_type::f64:
                 return 8;
+            case scan_data_type::bytes:
+            case scan_data_type::group:
+            case scan_data_type::numeric:
+                return 1;
         }
         return 1;
     }
 
+    std::size_t scanner::value_size(const scan_config& config) {
+        if (config.data_type == scan_data_type::bytes) {
+            const auto pattern = byte_pattern::parse(config.value_str);
+            return pattern ? pattern->size() : 1;
+        }
+        if (config.data_type == scan_data_type::group) {
+            std::size_t extent = 1;
+            for (const auto& field : config.fields) {
+                extent = std::max(extent, field.offset + type_size(field.type));
+            }
+            return extent;
+        }
+        // the widest of the types, each result is read as its own
+        if (config.data_type == scan_data_type::numeric)
+            return sizeof(std::uint64_t);
+        return type_size(config.data_type);
+    }
+
 
     std::string scanner::format_value(const std::vector<std::byte>& data, scan_data_type type) {
         if (data.size() < scanner::type_size(type))
@@ -374,6 +2084,15 @@ namespace core {
                 return std::format("{:.3f}", read_at<float>(data.data()));
             case scan_data_type::f64:
                 return std::format("{:.6f}", read_at<double>(data.data()));
+            case scan_data_type::bytes:
+            case scan_data_type::group:
+            case scan_data_type::numeric: {
+                std::string text;
+                for (const auto b : data) {
+                    text += std::format("{}{:02X}", text.empty() ? "" : " ", static_cast<unsigned>(b));
+                }
+                return text;
+            }
         }
     }
 
@@ -385,11 +2104,72 @@ namespace core {
         return scanning;
     }
 
+    std::size_t scanner::skipped_bytes() const {
+        return bytes_skipped;
+    }
+
     std::size_t scanner::result_count() const {
-        return results.size();
+        std::lock_guard lock(results_mutex);
+        return baseline ? baseline->candidate_count() : results.size();
     }
 
-    const std::vector<scan_result>& scanner::get_results() const {
+    bool scanner::has_snapshot() const {
+        return baseline.has_value();
+    }
+
+    bool scanner::is_relative(scan_compare_type type) {
+        switch (type) {
+            case scan_compare_type::changed:
+            case scan_compare_type::unchanged:
+            case scan_compare_type::increased:
+            case scan_compare_type::decreased:
+            case scan_compare_type::increased_by:
+            case scan_compare_type::decreased_by:
+            case scan_compare_type::within:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool scanner::needs_value(scan_compare_type type) {
+        switch (type) {
+            case scan_compare_type::exact:
+            case scan_compare_type::not_equal:
+            case scan_compare_type::greater:
+            case scan_compare_type::less:
+            case scan_compare_type::between:
+            case scan_compare_type::rounded:
+            case scan_compare_type::truncated:
+            case scan_compare_type::approx:
+            case scan_compare_type::increased_by:
+            case scan_compare_type::decreased_by:
+            case scan_compare_type::within:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    const result_store& scanner::get_results() const {
         return results;
     }
+
+    std::optional<scan_data_type> scanner::result_type(std::size_t index) const {
+        return tagged_type(results.tag(index));
+    }
+
+    std::uint8_t scanner::type_tag(scan_data_type type) {
+        return static_cast<std::uint8_t>(static_cast<std::uint8_t>(type) + 1);
+    }
+
+    std::optional<scan_data_type> scanner::tagged_type(std::uint8_t tag) {
+        if (tag == 0 || tag > type_tag(scan_data_type::f64))
+            return std::nullopt;
+        return static_cast<scan_data_type>(tag - 1);
+    }
+
+    const result_stream& scanner::get_stream() const {
+        return stream;
+    }
 } // namespace core
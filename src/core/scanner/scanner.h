@@ -2,11 +2,17 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <expected>
+#include <filesystem>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <variant>
 #include <vector>
+#include "core/scanner/result_store.h"
+#include "core/scanner/result_stream.h"
+#include "core/scanner/snapshot.h"
 #include "core/target.h"
 
 namespace core {
@@ -20,16 +26,29 @@ namespace core {
         u64,
         i64,
         f32,
-        f64
+        f64,
+        bytes, // value_str is a byte_pattern, only ever a first scan
+        group,  // the layout is scan_config::fields, results are where a group starts
+        numeric // the integer and float types from 16 bits up in one pass, each result keeps the type it matched as
     };
 
     enum class scan_compare_type : std::uint8_t {
         exact,
+        not_equal,
         greater,
         less,
-        // changed,
-        // unchanged,
-        // unknown // initial scan
+        between,      // inclusive, the value is written as "min..max"
+        rounded,      // floats that round to the value at the precision it was typed with
+        truncated,    // floats that truncate to the value at the precision it was typed with
+        approx,       // at most epsilon away from the value, written as "value~epsilon"
+        changed,      // relative to the previous scan
+        unchanged,    // relative to the previous scan
+        increased,    // relative to the previous scan
+        decreased,    // relative to the previous scan
+        increased_by, // relative to the previous scan, by exactly the value
+        decreased_by, // relative to the previous scan, by exactly the value
+        within,       // relative to the previous scan, at most the value away from it
+        unknown       // initial scan, snapshots memory instead of matching anything
     };
 
     struct scan_value {
@@ -37,9 +56,12 @@ namespace core {
         scan_data_type type;
     };
 
-    struct scan_result {
-        std::uintptr_t address;
-        std::vector<std::byte> original_bytes;
+    // one member of a group scan. offset is from the start of the group, compare can't be relative or unknown
+    struct scan_field {
+        std::size_t offset = 0;
+        scan_data_type type = scan_data_type::i32;
+        scan_compare_type compare = scan_compare_type::exact;
+        std::string value_str;
     };
 
     struct scan_config {
@@ -47,6 +69,10 @@ namespace core {
         scan_compare_type compare_type = scan_compare_type::exact;
         std::string value_str;
         bool fast_scan = true; // aligned scanning
+        std::size_t memory_budget = result_store::default_memory_budget; // results past this go to a temp file
+        std::size_t materialize_threshold = 1'000'000; // snapshot candidates are listed once fewer remain
+        std::vector<scan_field> fields;                // group scans only
+        bool resident_only = false; // first scans leave out pages that reading would fault in
     };
 
     class scanner {
@@ -68,35 +94,114 @@ namespace core {
 
         void cancel();
         void reset();
+        // blocks until the scan in progress is done, safe to call from any thread
+        void wait();
+
+        // drops every listed result whose entry in keep is 0, keep has one entry per result. does nothing while the
+        // candidates are a snapshot or a scan runs
+        void keep_results(std::span<const std::uint8_t> keep);
+
+        // writes the candidates and the config they were found with to path, see save_session
+        std::expected<void, error_code>
+        save_session(const std::filesystem::path& path, const scan_config& config) const;
+        // replaces the candidates with a saved session moved onto the current target and returns its config, a next
+        // scan then tells which of them still hold
+        std::expected<scan_config, error_code> load_session(const std::filesystem::path& path);
 
         float progress() const;
         bool is_scanning() const;
         std::size_t result_count() const;
-
-        const std::vector<scan_result>& get_results() const;
+        // bytes the last first scan left out with resident_only
+        std::size_t skipped_bytes() const;
+
+        // true while candidates only exist as a memory snapshot and get_results() is empty. same locking as
+        // get_results()
+        bool has_snapshot() const;
+        static bool is_relative(scan_compare_type type);
+        static bool needs_value(scan_compare_type type);
+
+        const result_store& get_results() const;
+        // the type a numeric scan found the result at index as, nothing for results of other scans. same locking as
+        // get_results()
+        std::optional<scan_data_type> result_type(std::size_t index) const;
+        // how numeric scans tag their segments
+        static std::uint8_t type_tag(scan_data_type type);
+        static std::optional<scan_data_type> tagged_type(std::uint8_t tag);
+        // hits of the scan in progress, readable without lock_results() while it runs. first and next scans stream
+        // what they find, unknown initial scans and next scans over a snapshot don't
+        const result_stream& get_stream() const;
         static std::size_t type_size(scan_data_type type);
+        // bytes one result covers, the pattern length for byte scans, the span of the fields for group scans and
+        // type_size for the rest
+        static std::size_t value_size(const scan_config& config);
         static std::string format_value(const std::vector<std::byte>& data, scan_data_type type);
-        static std::optional<std::vector<std::byte>> parse_input(const std::string& input, scan_data_type type);
+        // parses the value for a compare type. modes that take a range get their lower and upper bound back to
+        // back, every other mode a single value
+        static std::optional<std::vector<std::byte>> parse_input(
+                const std::string& input, scan_data_type type, scan_compare_type compare = scan_compare_type::exact
+        );
 
     private:
         target* active_target;
 
+        // per worker scratch, grown on first use
+        struct scan_buffers {
+            std::vector<std::byte> buffer;
+            std::vector<std::byte> previous;
+            std::vector<std::uint32_t> hits;
+            std::vector<std::byte> values;
+            std::vector<std::uint64_t> mask;
+            std::vector<read_request> requests;
+            std::vector<memory_run> runs;
+            std::vector<std::vector<std::uint32_t>> typed_hits; // numeric scans, one list per type
+            result_stream::cursor live;
+        };
+
+        // reads charged to the target's budget, failing once the scan is cancelled while waiting on it
+        std::expected<void, error_code> read_target(std::uintptr_t address, std::span<std::byte> buffer);
+        std::size_t read_target_batch(std::span<const read_request> requests, std::span<std::uint8_t> readable);
+        // the target's own bytes when it lends them, else read into buffer. empty when neither works. lent bytes
+        // cost no read and aren't charged
+        std::span<const std::byte> fetch(std::uintptr_t address, std::span<std::byte> buffer);
+
+        // writable regions, and executable ones as well when asked for
+        std::optional<std::vector<memory_region>> scan_regions(bool executable = false);
+        void advance_progress(std::size_t bytes);
+        // the parts of [address, address + size) to read, all of it unless only resident pages are wanted. bytes
+        // left out of the first own bytes count as skipped, the rest belongs to the next chunk
+        void chunk_runs(
+                std::uintptr_t address, std::size_t size, std::size_t own, bool resident_only,
+                std::vector<memory_run>& runs
+        );
+
         void worker_scan_first(scan_config config);
+        void worker_scan_numeric(scan_config config);
         void worker_scan_next(scan_config config);
+        void worker_scan_unknown(scan_config config);
+        void worker_scan_snapshot(scan_config config);
+        void worker_scan_pattern(scan_config config);
+        void worker_scan_group(scan_config config);
+        void worker_scan_group_next(scan_config config);
 
         template <typename T, typename Predicate>
         void scan_region(
-                std::uintptr_t base, std::span<const std::byte> buffer, Predicate pred,
-                std::vector<scan_result>& local_results, std::size_t align
+                std::uintptr_t base, std::span<const std::byte> buffer, Predicate pred, result_store& store,
+                std::vector<result_store::segment>& segments, scan_buffers& scratch, std::size_t align
         );
 
-        std::vector<scan_result> results;
+        result_store results;
+        result_stream stream;
+        std::optional<snapshot> baseline;
+        // write tracking generation the results or the baseline were read in, rescans reuse what they hold for
+        // pages nothing wrote to since
+        std::optional<std::uint32_t> results_generation;
         mutable std::mutex results_mutex;
 
         std::atomic<bool> scanning = false;
         std::atomic<bool> cancel_req = false;
         std::atomic<float> progress_val = 0.0f;
         std::atomic<std::size_t> bytes_scanned = 0;
+        std::atomic<std::size_t> bytes_skipped = 0;
         std::size_t total_scan_bytes = 0;
 
         std::jthread scan_thread;
@@ -0,0 +1,525 @@
+#include <core/scanner/session.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "core/scanner/anchors.h"
+#include "util/varint.h"
+
+namespace core {
+    namespace {
+        constexpr std::array<char, 4> file_magic = {'R', 'V', 'S', 'S'};
+        constexpr std::uint8_t file_version = 3;
+
+        // results per run in the file and per segment once loaded
+        constexpr std::size_t run_size = 64 * 1024;
+        constexpr std::size_t flush_size = 1024 * 1024;
+        constexpr std::uint64_t max_string = 64 * 1024;
+        constexpr std::uint64_t max_value_size = 4096;
+
+        // collects the file in memory and hands it to the stream a block at a time
+        class session_writer {
+        public:
+            explicit session_writer(const std::filesystem::path& path) :
+                m_file(path, std::ios::binary | std::ios::trunc) {
+            }
+
+            explicit operator bool() const {
+                return static_cast<bool>(m_file);
+            }
+
+            void byte(std::uint8_t value) {
+                m_buffer.push_back(value);
+            }
+
+            void varint(std::uint64_t value) {
+                put_varint(m_buffer, value);
+            }
+
+            void string(std::string_view value) {
+                varint(value.size());
+                m_buffer.insert(m_buffer.end(), value.begin(), value.end());
+            }
+
+            void bytes(std::span<const std::byte> data) {
+                const auto* begin = reinterpret_cast<const std::uint8_t*>(data.data());
+                m_buffer.insert(m_buffer.end(), begin, begin + data.size());
+                if (m_buffer.size() >= flush_size) {
+                    flush();
+                }
+            }
+
+            bool flush() {
+                m_file.write(
+                        reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size())
+                );
+                m_buffer.clear();
+                return m_file.good();
+            }
+
+        private:
+            std::ofstream m_file;
+            std::vector<std::uint8_t> m_buffer;
+        };
+
+        // every read is checked against the bytes left in the file before anything gets sized by it
+        class session_reader {
+        public:
+            explicit session_reader(const std::filesystem::path& path) : m_file(path, std::ios::binary) {
+                std::error_code ec;
+                const auto size = std::filesystem::file_size(path, ec);
+                m_left = ec ? 0 : size;
+            }
+
+            explicit operator bool() const {
+                return static_cast<bool>(m_file);
+            }
+
+            [[nodiscard]] std::uint64_t left() const {
+                return m_left;
+            }
+
+            std::optional<std::uint8_t> byte() {
+                if (m_left == 0)
+                    return std::nullopt;
+
+                const auto c = m_file.get();
+                if (c == std::ifstream::traits_type::eof())
+                    return std::nullopt;
+                --m_left;
+                return static_cast<std::uint8_t>(c);
+            }
+
+            std::optional<std::uint64_t> varint() {
+                std::uint64_t value = 0;
+                for (unsigned shift = 0; shift < 64; shift += 7) {
+                    const auto b = byte();
+                    if (!b)
+                        return std::nullopt;
+
+                    value |= static_cast<std::uint64_t>(*b & 0x7f) << shift;
+                    if ((*b & 0x80) == 0)
+                        return value;
+                }
+                return std::nullopt;
+            }
+
+            std::optional<std::string> string() {
+                const auto length = varint();
+                if (!length || *length > std::min(m_left, max_string))
+                    return std::nullopt;
+
+                std::string value(*length, '\0');
+                if (!bytes(std::as_writable_bytes(std::span(value))))
+                    return std::nullopt;
+                return value;
+            }
+
+            bool bytes(std::span<std::byte> out) {
+                if (out.size() > m_left)
+                    return false;
+
+                m_file.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+                m_left -= out.size();
+                return m_file.good();
+            }
+
+        private:
+            std::ifstream m_file;
+            std::uint64_t m_left = 0;
+        };
+
+        void put_key(session_writer& out, const anchor_key& key) {
+            out.string(key.name);
+            out.varint(key.extent);
+            out.varint(key.ordinal);
+        }
+
+        std::optional<anchor_key> get_key(session_reader& in) {
+            auto name = in.string();
+            const auto extent = in.varint();
+            const auto ordinal = in.varint();
+            if (!name || !extent || !ordinal)
+                return std::nullopt;
+            return anchor_key{std::move(*name), *extent, *ordinal};
+        }
+
+        void put_config(session_writer& out, const scan_config& config) {
+            out.byte(static_cast<std::uint8_t>(config.data_type));
+            out.byte(static_cast<std::uint8_t>(config.compare_type));
+            out.string(config.value_str);
+            out.byte(config.fast_scan ? 1 : 0);
+            out.byte(config.resident_only ? 1 : 0);
+            out.varint(config.memory_budget);
+            out.varint(config.materialize_threshold);
+
+            out.varint(config.fields.size());
+            for (const auto& field : config.fields) {
+                out.varint(field.offset);
+                out.byte(static_cast<std::uint8_t>(field.type));
+                out.byte(static_cast<std::uint8_t>(field.compare));
+                out.string(field.value_str);
+            }
+        }
+
+        std::optional<scan_config> get_config(session_reader& in) {
+            constexpr auto last_type = static_cast<std::uint8_t>(scan_data_type::numeric);
+            constexpr auto last_field_type = static_cast<std::uint8_t>(scan_data_type::f64);
+            constexpr auto last_compare = static_cast<std::uint8_t>(scan_compare_type::unknown);
+
+            const auto type = in.byte();
+            const auto compare = in.byte();
+            auto value = in.string();
+            const auto fast_scan = in.byte();
+            const auto resident_only = in.byte();
+            const auto memory_budget = in.varint();
+            const auto materialize_threshold = in.varint();
+            const auto field_count = in.varint();
+            if (!type || !compare || !value || !fast_scan || !resident_only || !memory_budget ||
+                !materialize_threshold || !field_count || *type > last_type || *compare > last_compare ||
+                *field_count > in.left())
+                return std::nullopt;
+
+            scan_config config;
+            config.data_type = static_cast<scan_data_type>(*type);
+            config.compare_type = static_cast<scan_compare_type>(*compare);
+            config.value_str = std::move(*value);
+            config.fast_scan = *fast_scan != 0;
+            config.resident_only = *resident_only != 0;
+            config.memory_budget = *memory_budget;
+            config.materialize_threshold = *materialize_threshold;
+
+            for (std::uint64_t i = 0; i < *field_count; ++i) {
+                const auto offset = in.varint();
+                const auto field_type = in.byte();
+                const auto field_compare = in.byte();
+                auto field_value = in.string();
+                if (!offset || !field_type || !field_compare || !field_value || *field_type > last_field_type ||
+                    *field_compare > last_compare)
+                    return std::nullopt;
+
+                config.fields.push_back(
+                        {*offset, static_cast<scan_data_type>(*field_type),
+                         static_cast<scan_compare_type>(*field_compare), std::move(*field_value)}
+                );
+            }
+            return config;
+        }
+    } // namespace
+
+    std::expected<void, error_code> save_session(
+            const std::filesystem::path& path, target& t, const scan_config& config, const result_store& results,
+            const snapshot* baseline
+    ) {
+        auto regions = t.get_memory_regions();
+        if (!regions)
+            return std::unexpected(regions.error());
+        const auto anchors = find_anchors(std::move(*regions));
+
+        session_writer out(path);
+        if (!out)
+            return std::unexpected(error_code::write_failed);
+
+        out.bytes(std::as_bytes(std::span(file_magic)));
+        out.byte(file_version);
+        put_config(out, config);
+
+        // results go as runs inside one region and one segment, a count, the region, the tag and value size of the
+        // segment, the offset of the first one and the gaps to the ones after it, then the values read at them. a
+        // zero count ends the list
+        std::vector<std::uintptr_t> window(run_size);
+        std::vector<std::byte> values;
+        for (const auto& seg : results.segments()) {
+            const std::size_t value_size = seg.value_size;
+            values.resize(run_size * value_size);
+
+            for (std::size_t done = 0; done < seg.count;) {
+                const std::size_t want = std::min<std::size_t>(run_size, seg.count - done);
+                const std::size_t count =
+                        results.read(seg.first_index + done, std::span(window).first(want), values, value_size);
+                if (count == 0)
+                    break;
+                done += count;
+
+                for (std::size_t i = 0; i < count;) {
+                    const anchor* at = owning_anchor(anchors, window[i]);
+                    if (!at) {
+                        ++i;
+                        continue;
+                    }
+
+                    std::size_t end = i + 1;
+                    while (end < count && window[end] - at->base < at->size) {
+                        ++end;
+                    }
+
+                    out.varint(end - i);
+                    put_key(out, at->key);
+                    out.byte(seg.tag);
+                    out.varint(value_size);
+                    std::uintptr_t previous = at->base;
+                    for (std::size_t k = i; k < end; ++k) {
+                        out.varint(window[k] - previous);
+                        previous = window[k];
+                    }
+                    out.bytes(std::span(values).subspan(i * value_size, (end - i) * value_size));
+                    i = end;
+                }
+            }
+        }
+        out.varint(0);
+
+        // the baseline region by region. a page either carries its contents and mask right after it or refers to
+        // ones written earlier, so pages that are identical stay shared in the file as well
+        out.byte(baseline ? 1 : 0);
+        if (baseline) {
+            out.varint(baseline->align());
+
+            std::unordered_map<std::uint32_t, std::uint64_t> data_refs;
+            std::unordered_map<std::uint32_t, std::uint64_t> mask_refs;
+            for (const auto& region : baseline->regions()) {
+                const anchor* at = owning_anchor(anchors, region.base);
+                if (!at || region.pages.empty())
+                    continue;
+
+                out.varint(region.pages.size());
+                put_key(out, at->key);
+                out.varint(region.base - at->base);
+                out.varint(region.size);
+
+                for (const auto& page : region.pages) {
+                    // 0 not copied, 1 the contents follow, n the contents written as number n - 2
+                    if (page.data == snapshot::none) {
+                        out.varint(0);
+                    } else if (auto it = data_refs.find(page.data); it != data_refs.end()) {
+                        out.varint(it->second + 2);
+                    } else {
+                        data_refs.emplace(page.data, data_refs.size());
+                        out.varint(1);
+                        out.bytes(std::span(baseline->data(page.data), snapshot::page_size));
+                    }
+
+                    // 0 no candidates, 1 all of them, 2 the mask follows, n the mask written as number n - 3
+                    if (page.mask == snapshot::none) {
+                        out.varint(0);
+                    } else if (page.mask == snapshot::all) {
+                        out.varint(1);
+                    } else if (auto it = mask_refs.find(page.mask); it != mask_refs.end()) {
+                        out.varint(it->second + 3);
+                    } else {
+                        mask_refs.emplace(page.mask, mask_refs.size());
+                        out.varint(2);
+                        out.bytes(std::as_bytes(std::span(baseline->mask(page.mask), baseline->mask_words())));
+                    }
+                }
+            }
+            out.varint(0);
+        }
+
+        if (!out.flush())
+            return std::unexpected(error_code::write_failed);
+        return {};
+    }
+
+    std::expected<scan_session, error_code> load_session(const std::filesystem::path& path, target& t) {
+        session_reader in(path);
+        if (!in)
+            return std::unexpected(error_code::read_failed);
+
+        std::array<char, 4> magic{};
+        if (!in.bytes(std::as_writable_bytes(std::span(magic))) || magic != file_magic || in.byte() != file_version)
+            return std::unexpected(error_code::invalid_format);
+
+        auto config = get_config(in);
+        if (!config)
+            return std::unexpected(error_code::invalid_format);
+
+        auto regions = t.get_memory_regions();
+        if (!regions)
+            return std::unexpected(regions.error());
+        const auto anchors = find_anchors(std::move(*regions));
+
+        std::map<anchor_key, const anchor*> by_key;
+        for (const auto& a : anchors) {
+            by_key.emplace(a.key, &a);
+        }
+        auto locate = [&](const anchor_key& key) -> const anchor* {
+            auto it = by_key.find(key);
+            return it == by_key.end() ? nullptr : it->second;
+        };
+
+        scan_session session{
+                .config = *config, .results = result_store(config->memory_budget), .baseline = std::nullopt
+        };
+
+        std::vector<result_store::segment> segments;
+        std::vector<std::uint64_t> offsets;
+        std::vector<std::uint32_t> relative;
+        std::vector<std::byte> values;
+        while (true) {
+            const auto count = in.varint();
+            if (!count)
+                return std::unexpected(error_code::invalid_format);
+            if (*count == 0)
+                break;
+
+            const auto key = get_key(in);
+            const auto tag = in.byte();
+            const auto value_size = in.varint();
+            if (!key || !tag || !value_size || *value_size > max_value_size || *count > in.left())
+                return std::unexpected(error_code::invalid_format);
+
+            // the alignment first scans found them at, segments fall back to byte slots where it doesn't hold
+            std::size_t align = 1;
+            if (const auto type = scanner::tagged_type(*tag); config->fast_scan && type) {
+                align = scanner::type_size(*type);
+            } else if (config->fast_scan && config->data_type < scan_data_type::bytes) {
+                align = scanner::type_size(config->data_type);
+            }
+
+            // offsets have to be strictly increasing, the segments they go into rely on it
+            offsets.resize(*count);
+            std::uint64_t offset = 0;
+            for (std::size_t i = 0; i < offsets.size(); ++i) {
+                const auto gap = in.varint();
+                if (!gap || (i > 0 && *gap == 0) || *gap > UINT64_MAX - offset)
+                    return std::unexpected(error_code::invalid_format);
+                offset += *gap;
+                offsets[i] = offset;
+            }
+
+            if (*count * *value_size > in.left())
+                return std::unexpected(error_code::invalid_format);
+            values.resize(*count * *value_size);
+            if (!in.bytes(values))
+                return std::unexpected(error_code::invalid_format);
+
+            // results past the end of a region that shrank go with the ones of regions that are gone
+            const anchor* at = locate(*key);
+            for (std::size_t i = 0; i < offsets.size();) {
+                if (!at || offsets[i] >= at->size) {
+                    ++session.dropped;
+                    ++i;
+                    continue;
+                }
+
+                const std::uint64_t first = offsets[i];
+                relative.clear();
+                std::size_t end = i;
+                while (end < offsets.size() && relative.size() < run_size && offsets[end] < at->size &&
+                       offsets[end] - first <= UINT32_MAX) {
+                    relative.push_back(static_cast<std::uint32_t>(offsets[end] - first));
+                    ++end;
+                }
+
+                const auto run_values = std::span(values).subspan(i * *value_size, (end - i) * *value_size);
+                segments.push_back(session.results.encode(at->base + first, align, relative, run_values, *tag));
+                i = end;
+            }
+        }
+
+        // regions can come back in another order, segments still have to go in by address, per type for the results
+        // of numeric scans
+        std::ranges::sort(segments, {}, [](const result_store::segment& seg) {
+            return std::pair(seg.tag, seg.base);
+        });
+        for (const auto& seg : segments) {
+            session.results.push(seg);
+        }
+
+        const auto has_baseline = in.byte();
+        if (!has_baseline || *has_baseline > 1)
+            return std::unexpected(error_code::invalid_format);
+        if (*has_baseline == 0)
+            return session;
+
+        const auto snap_align = in.varint();
+        if (!snap_align || *snap_align == 0 || *snap_align > sizeof(std::uint64_t) || !std::has_single_bit(*snap_align))
+            return std::unexpected(error_code::invalid_format);
+
+        snapshot snap(*snap_align);
+        std::vector<std::uint32_t> data_slots;
+        std::vector<std::uint32_t> mask_slots;
+        std::vector<std::byte> page_data(snapshot::page_size);
+        std::vector<std::uint64_t> mask(snap.mask_words());
+        std::size_t candidates = 0;
+
+        while (true) {
+            const auto page_count = in.varint();
+            if (!page_count)
+                return std::unexpected(error_code::invalid_format);
+            if (*page_count == 0)
+                break;
+
+            const auto key = get_key(in);
+            const auto offset = in.varint();
+            const auto size = in.varint();
+            if (!key || !offset || !size || *page_count > in.left() || *size == 0 ||
+                (*size - 1) / snapshot::page_size + 1 != *page_count)
+                return std::unexpected(error_code::invalid_format);
+
+            // pages of regions that are gone are still read, later ones can refer to their contents
+            const anchor* at = locate(*key);
+            snapshot::region* region = at ? &snap.add_region(at->base + *offset, *size) : nullptr;
+
+            for (std::uint64_t p = 0; p < *page_count; ++p) {
+                snapshot::page entry;
+
+                const auto data_ref = in.varint();
+                if (!data_ref || (*data_ref >= 2 && *data_ref - 2 >= data_slots.size()))
+                    return std::unexpected(error_code::invalid_format);
+                if (*data_ref == 1) {
+                    if (!in.bytes(page_data))
+                        return std::unexpected(error_code::invalid_format);
+                    data_slots.push_back(snap.store_data(page_data));
+                    entry.data = data_slots.back();
+                } else if (*data_ref >= 2) {
+                    entry.data = data_slots[*data_ref - 2];
+                }
+
+                const auto mask_ref = in.varint();
+                if (!mask_ref || (*mask_ref >= 3 && *mask_ref - 3 >= mask_slots.size()))
+                    return std::unexpected(error_code::invalid_format);
+                if (*mask_ref == 1) {
+                    entry.mask = snapshot::all;
+                } else if (*mask_ref == 2) {
+                    if (!in.bytes(std::as_writable_bytes(std::span(mask))))
+                        return std::unexpected(error_code::invalid_format);
+                    mask_slots.push_back(snap.store_mask(mask));
+                    entry.mask = mask_slots.back();
+                } else if (*mask_ref >= 3) {
+                    entry.mask = mask_slots[*mask_ref - 3];
+                }
+
+                if (!region) {
+                    session.dropped += entry.mask != snapshot::none;
+                    continue;
+                }
+
+                region->pages[p] = entry;
+                if (entry.mask == snapshot::all) {
+                    const std::uint64_t left = *size - p * snapshot::page_size;
+                    candidates += std::min<std::uint64_t>(snapshot::page_size, left) / snap.align();
+                } else if (entry.mask != snapshot::none) {
+                    const std::uint64_t* words = snap.mask(entry.mask);
+                    for (std::size_t w = 0; w < snap.mask_words(); ++w) {
+                        candidates += static_cast<std::size_t>(std::popcount(words[w]));
+                    }
+                }
+            }
+        }
+
+        snap.add_candidates(candidates);
+        session.baseline = std::move(snap);
+        return session;
+    }
+} // namespace core
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include "core/scanner/result_store.h"
+#include "core/scanner/scanner.h"
+#include "core/scanner/snapshot.h"
+#include "core/target.h"
+
+namespace core {
+    // a saved scan as it was read back, moved to wherever its regions are in the target now
+    struct scan_session {
+        scan_config config;
+        result_store results;
+        std::optional<snapshot> baseline;
+        std::size_t dropped = 0; // results and snapshot pages whose region the target doesn't have anymore
+    };
+
+    // sessions keep every address as an offset into the region holding it. a region goes by the file mapped there,
+    // or the one it directly follows for the anonymous bss of an image, by its own name otherwise and by its size
+    // when it has no name, together with how many regions going by the same come before it. a restarted target
+    // maps those in the same order, so a loaded session lands where it belongs and one next scan tells which
+    // results still hold
+    std::expected<void, error_code> save_session(
+            const std::filesystem::path& path, target& t, const scan_config& config, const result_store& results,
+            const snapshot* baseline
+    );
+
+    std::expected<scan_session, error_code> load_session(const std::filesystem::path& path, target& t);
+} // namespace core
@@ -0,0 +1,124 @@
+#include <core/scanner/simd.h>
+#include <core/scanner/simd_kernels.h>
+
+#include <array>
+
+#if defined(RAVEL_SIMD_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace core::simd {
+    namespace {
+#if defined(RAVEL_SIMD_X86)
+        std::array<std::uint32_t, 4> cpuid(std::uint32_t leaf, std::uint32_t sub) {
+            std::array<std::uint32_t, 4> regs{};
+#if defined(_MSC_VER)
+            int out[4];
+            __cpuidex(out, static_cast<int>(leaf), static_cast<int>(sub));
+            for (std::size_t i = 0; i < regs.size(); ++i) {
+                regs[i] = static_cast<std::uint32_t>(out[i]);
+            }
+#else
+            __cpuid_count(leaf, sub, regs[0], regs[1], regs[2], regs[3]);
+#endif
+            return regs;
+        }
+
+        std::uint64_t xgetbv() {
+#if defined(_MSC_VER)
+            return _xgetbv(0);
+#else
+            std::uint32_t lo, hi;
+            __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            return (static_cast<std::uint64_t>(hi) << 32) | lo;
+#endif
+        }
+
+        level detect() {
+            const auto max_leaf = cpuid(0, 0)[0];
+            const auto leaf1 = cpuid(1, 0);
+
+            // the os has to save the wider registers on context switch too, not just the cpu support them
+            const bool osxsave = (leaf1[2] & (1u << 27)) != 0;
+            const std::uint64_t xcr0 = osxsave ? xgetbv() : 0;
+            const bool ymm_state = (xcr0 & 0x6) == 0x6;
+            const bool zmm_state = (xcr0 & 0xE6) == 0xE6;
+
+            if (max_leaf >= 7 && ymm_state) {
+                const auto leaf7 = cpuid(7, 0);
+                const bool avx2 = (leaf7[1] & (1u << 5)) != 0;
+                const bool bmi2 = (leaf7[1] & (1u << 8)) != 0;
+                const bool avx512f = (leaf7[1] & (1u << 16)) != 0;
+                const bool avx512bw = (leaf7[1] & (1u << 30)) != 0;
+
+                if (zmm_state && avx512f && avx512bw && bmi2) {
+                    return level::avx512;
+                }
+                if (avx2) {
+                    return level::avx2;
+                }
+            }
+
+            // baseline for x86-64
+            return level::sse2;
+        }
+#else
+        level detect() {
+            return level::scalar;
+        }
+#endif
+    } // namespace
+
+    level supported_level() {
+        static const level detected = detect();
+        return detected;
+    }
+
+    template <typename T>
+    kernel<T> select(predicate p, source s, level l) {
+        switch (l) {
+#if defined(RAVEL_SIMD_X86)
+            case level::avx512:
+                return detail::avx512_kernel<T>(p, s);
+            case level::avx2:
+                return detail::avx2_kernel<T>(p, s);
+            case level::sse2:
+                return detail::sse2_kernel<T>(p, s);
+#endif
+            default:
+                return detail::scalar_kernel<T>(p, s);
+        }
+    }
+
+    pair_kernel select_pair(level l) {
+        switch (l) {
+#if defined(RAVEL_SIMD_X86)
+            case level::avx512:
+                return detail::avx512_pair_kernel();
+            case level::avx2:
+                return detail::avx2_pair_kernel();
+            case level::sse2:
+                return detail::sse2_pair_kernel();
+#endif
+            default:
+                return [](std::span<const std::byte> data, byte_pair pair, std::uint32_t* out) {
+                    return find_pair_scalar(data, 0, pair, out);
+                };
+        }
+    }
+
+    namespace detail {
+        template <typename T>
+        kernel<T> scalar_kernel(predicate p, source s) {
+            return pick_reference<T>(p, s);
+        }
+
+        RAVEL_SIMD_INSTANTIATE(scalar_kernel, predicate, source)
+    } // namespace detail
+
+    RAVEL_SIMD_INSTANTIATE(select, predicate, source, level)
+} // namespace core::simd
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define RAVEL_SIMD_X86 1
+#endif
+
+namespace core::simd {
+    enum class level : std::uint8_t {
+        scalar,
+        sse2,
+        avx2,
+        avx512
+    };
+
+    enum class predicate : std::uint8_t {
+        eq,
+        ne,
+        gt,
+        lt,
+        between // inclusive on both ends
+    };
+
+    // what every loaded value is compared against
+    enum class source : std::uint8_t {
+        constant, // operands::value, and operands::upper for between
+        previous  // the value at the same offset of operands::previous, and of operands::previous_upper for between
+    };
+
+    template <typename T>
+    struct operands {
+        T value{};
+        T upper{};
+        const std::byte* previous = nullptr; // at least as long as data
+        const std::byte* previous_upper = nullptr;
+    };
+
+    // writes the offset of every value starting at a multiple of align that satisfies the predicate,
+    // in ascending order. out must have room for data.size() / align + 1 entries
+    template <typename T>
+    using kernel = std::size_t (*)(
+            std::span<const std::byte> data, std::size_t align, operands<T> args, std::uint32_t* out
+    );
+
+    // highest level supported by both the cpu and the os, detected once
+    level supported_level();
+
+    template <typename T>
+    kernel<T> select(predicate p, source s, level l);
+
+    template <typename T>
+    kernel<T> select(predicate p, source s = source::constant) {
+        return select<T>(p, s, supported_level());
+    }
+
+    // two fixed bytes of a byte pattern and where they sit in it, first_at <= last_at
+    struct byte_pair {
+        std::uint8_t first = 0;
+        std::uint8_t last = 0;
+        std::size_t first_at = 0;
+        std::size_t last_at = 0;
+    };
+
+    // writes every offset i with both bytes of the pair in place relative to it, in ascending order. only offsets
+    // where data[i + last_at] is still inside data are tried. out must have room for data.size() + 1 entries
+    using pair_kernel = std::size_t (*)(std::span<const std::byte> data, byte_pair pair, std::uint32_t* out);
+
+    pair_kernel select_pair(level l);
+
+    inline pair_kernel select_pair() {
+        return select_pair(supported_level());
+    }
+
+    namespace detail {
+        template <typename T>
+        kernel<T> scalar_kernel(predicate p, source s);
+#if defined(RAVEL_SIMD_X86)
+        template <typename T>
+        kernel<T> sse2_kernel(predicate p, source s);
+        template <typename T>
+        kernel<T> avx2_kernel(predicate p, source s);
+        template <typename T>
+        kernel<T> avx512_kernel(predicate p, source s);
+
+        pair_kernel sse2_pair_kernel();
+        pair_kernel avx2_pair_kernel();
+        pair_kernel avx512_pair_kernel();
+#endif
+    } // namespace detail
+} // namespace core::simd
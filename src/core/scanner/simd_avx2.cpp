@@ -0,0 +1,164 @@
+#include <core/scanner/simd.h>
+
+#if defined(RAVEL_SIMD_X86)
+
+#include <core/scanner/simd_kernels.h>
+
+#include <type_traits>
+
+#include <immintrin.h>
+
+namespace core::simd {
+    namespace {
+        template <typename T>
+        struct avx2_int {
+            using vec = __m256i;
+            static constexpr std::size_t width = 32;
+            static constexpr std::uint64_t starts = lane_starts<T>(width);
+
+            static vec load(const std::byte* p) {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            }
+
+            static vec broadcast(T v) {
+                if constexpr (sizeof(T) == 1) {
+                    return _mm256_set1_epi8(static_cast<char>(v));
+                } else if constexpr (sizeof(T) == 2) {
+                    return _mm256_set1_epi16(static_cast<short>(v));
+                } else if constexpr (sizeof(T) == 4) {
+                    return _mm256_set1_epi32(static_cast<int>(v));
+                } else {
+                    return _mm256_set1_epi64x(static_cast<long long>(v));
+                }
+            }
+
+            static std::uint64_t mask(vec m) {
+                return static_cast<std::uint32_t>(_mm256_movemask_epi8(m)) & starts;
+            }
+
+            static vec to_signed(vec v) {
+                if constexpr (std::is_signed_v<T>) {
+                    return v;
+                } else {
+                    return _mm256_xor_si256(v, broadcast(static_cast<T>(T{1} << (sizeof(T) * 8 - 1))));
+                }
+            }
+
+            static vec cmpeq(vec a, vec b) {
+                if constexpr (sizeof(T) == 1) {
+                    return _mm256_cmpeq_epi8(a, b);
+                } else if constexpr (sizeof(T) == 2) {
+                    return _mm256_cmpeq_epi16(a, b);
+                } else if constexpr (sizeof(T) == 4) {
+                    return _mm256_cmpeq_epi32(a, b);
+                } else {
+                    return _mm256_cmpeq_epi64(a, b);
+                }
+            }
+
+            static vec cmpgt(vec a, vec b) {
+                if constexpr (sizeof(T) == 1) {
+                    return _mm256_cmpgt_epi8(a, b);
+                } else if constexpr (sizeof(T) == 2) {
+                    return _mm256_cmpgt_epi16(a, b);
+                } else if constexpr (sizeof(T) == 4) {
+                    return _mm256_cmpgt_epi32(a, b);
+                } else {
+                    return _mm256_cmpgt_epi64(a, b);
+                }
+            }
+
+            static std::uint64_t eq(vec a, vec b) {
+                return mask(cmpeq(a, b));
+            }
+
+            static std::uint64_t gt(vec a, vec b) {
+                return mask(cmpgt(to_signed(a), to_signed(b)));
+            }
+
+            static std::uint64_t lt(vec a, vec b) {
+                return gt(b, a);
+            }
+        };
+
+        struct avx2_f32 {
+            using vec = __m256;
+            static constexpr std::size_t width = 32;
+            static constexpr std::uint64_t starts = lane_starts<float>(width);
+
+            static vec load(const std::byte* p) {
+                return _mm256_loadu_ps(reinterpret_cast<const float*>(p));
+            }
+
+            static vec broadcast(float v) {
+                return _mm256_set1_ps(v);
+            }
+
+            static std::uint64_t mask(vec m) {
+                return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_castps_si256(m))) & starts;
+            }
+
+            static std::uint64_t eq(vec a, vec b) {
+                return mask(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+            }
+
+            static std::uint64_t gt(vec a, vec b) {
+                return mask(_mm256_cmp_ps(a, b, _CMP_GT_OQ));
+            }
+
+            static std::uint64_t lt(vec a, vec b) {
+                return mask(_mm256_cmp_ps(a, b, _CMP_LT_OQ));
+            }
+        };
+
+        struct avx2_f64 {
+            using vec = __m256d;
+            static constexpr std::size_t width = 32;
+            static constexpr std::uint64_t starts = lane_starts<double>(width);
+
+            static vec load(const std::byte* p) {
+                return _mm256_loadu_pd(reinterpret_cast<const double*>(p));
+            }
+
+            static vec broadcast(double v) {
+                return _mm256_set1_pd(v);
+            }
+
+            static std::uint64_t mask(vec m) {
+                return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_castpd_si256(m))) & starts;
+            }
+
+            static std::uint64_t eq(vec a, vec b) {
+                return mask(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+            }
+
+            static std::uint64_t gt(vec a, vec b) {
+                return mask(_mm256_cmp_pd(a, b, _CMP_GT_OQ));
+            }
+
+            static std::uint64_t lt(vec a, vec b) {
+                return mask(_mm256_cmp_pd(a, b, _CMP_LT_OQ));
+            }
+        };
+
+        template <typename T>
+        using avx2_ops = std::conditional_t<
+                std::is_same_v<T, float>, avx2_f32,
+                std::conditional_t<std::is_same_v<T, double>, avx2_f64, avx2_int<T>>>;
+    } // namespace
+
+    namespace detail {
+        template <typename T>
+        kernel<T> avx2_kernel(predicate p, source s) {
+            return pick_vector<avx2_ops, T>(p, s);
+        }
+
+        RAVEL_SIMD_INSTANTIATE(avx2_kernel, predicate, source)
+
+        pair_kernel avx2_pair_kernel() {
+            return &find_pair_vector<avx2_int<std::uint8_t>>;
+        }
+    } // namespace detail
+} // namespace core::simd
+
+#endif
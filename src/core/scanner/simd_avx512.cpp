@@ -0,0 +1,144 @@
+#include <core/scanner/simd.h>
+
+#if defined(RAVEL_SIMD_X86)
+
+#include <core/scanner/simd_kernels.h>
+
+#include <type_traits>
+
+#include <immintrin.h>
+
+namespace core::simd {
+    namespace {
+        // compares yield one mask bit per lane, pdep moves lane j to the byte offset it starts at
+        template <typename T>
+        std::uint64_t spread(std::uint64_t lanes) {
+            if constexpr (sizeof(T) == 1) {
+                return lanes;
+            } else {
+                return _pdep_u64(lanes, lane_starts<T>(64));
+            }
+        }
+
+        template <typename T>
+        struct avx512_int {
+            using vec = __m512i;
+            static constexpr std::size_t width = 64;
+
+            static vec load(const std::byte* p) {
+                return _mm512_loadu_si512(p);
+            }
+
+            static vec broadcast(T v) {
+                if constexpr (sizeof(T) == 1) {
+                    return _mm512_set1_epi8(static_cast<char>(v));
+                } else if constexpr (sizeof(T) == 2) {
+                    return _mm512_set1_epi16(static_cast<short>(v));
+                } else if constexpr (sizeof(T) == 4) {
+                    return _mm512_set1_epi32(static_cast<int>(v));
+                } else {
+                    return _mm512_set1_epi64(static_cast<long long>(v));
+                }
+            }
+
+            static std::uint64_t eq(vec a, vec b) {
+                if constexpr (sizeof(T) == 1) {
+                    return spread<T>(_mm512_cmpeq_epi8_mask(a, b));
+                } else if constexpr (sizeof(T) == 2) {
+                    return spread<T>(_mm512_cmpeq_epi16_mask(a, b));
+                } else if constexpr (sizeof(T) == 4) {
+                    return spread<T>(_mm512_cmpeq_epi32_mask(a, b));
+                } else {
+                    return spread<T>(_mm512_cmpeq_epi64_mask(a, b));
+                }
+            }
+
+            static std::uint64_t gt(vec a, vec b) {
+                constexpr bool is_signed = std::is_signed_v<T>;
+                if constexpr (sizeof(T) == 1) {
+                    return spread<T>(is_signed ? _mm512_cmpgt_epi8_mask(a, b) : _mm512_cmpgt_epu8_mask(a, b));
+                } else if constexpr (sizeof(T) == 2) {
+                    return spread<T>(is_signed ? _mm512_cmpgt_epi16_mask(a, b) : _mm512_cmpgt_epu16_mask(a, b));
+                } else if constexpr (sizeof(T) == 4) {
+                    return spread<T>(is_signed ? _mm512_cmpgt_epi32_mask(a, b) : _mm512_cmpgt_epu32_mask(a, b));
+                } else {
+                    return spread<T>(is_signed ? _mm512_cmpgt_epi64_mask(a, b) : _mm512_cmpgt_epu64_mask(a, b));
+                }
+            }
+
+            static std::uint64_t lt(vec a, vec b) {
+                return gt(b, a);
+            }
+        };
+
+        struct avx512_f32 {
+            using vec = __m512;
+            static constexpr std::size_t width = 64;
+
+            static vec load(const std::byte* p) {
+                return _mm512_loadu_ps(p);
+            }
+
+            static vec broadcast(float v) {
+                return _mm512_set1_ps(v);
+            }
+
+            static std::uint64_t eq(vec a, vec b) {
+                return spread<float>(_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ));
+            }
+
+            static std::uint64_t gt(vec a, vec b) {
+                return spread<float>(_mm512_cmp_ps_mask(a, b, _CMP_GT_OQ));
+            }
+
+            static std::uint64_t lt(vec a, vec b) {
+                return spread<float>(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ));
+            }
+        };
+
+        struct avx512_f64 {
+            using vec = __m512d;
+            static constexpr std::size_t width = 64;
+
+            static vec load(const std::byte* p) {
+                return _mm512_loadu_pd(p);
+            }
+
+            static vec broadcast(double v) {
+                return _mm512_set1_pd(v);
+            }
+
+            static std::uint64_t eq(vec a, vec b) {
+                return spread<double>(_mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ));
+            }
+
+            static std::uint64_t gt(vec a, vec b) {
+                return spread<double>(_mm512_cmp_pd_mask(a, b, _CMP_GT_OQ));
+            }
+
+            static std::uint64_t lt(vec a, vec b) {
+                return spread<double>(_mm512_cmp_pd_mask(a, b, _CMP_LT_OQ));
+            }
+        };
+
+        template <typename T>
+        using avx512_ops = std::conditional_t<
+                std::is_same_v<T, float>, avx512_f32,
+                std::conditional_t<std::is_same_v<T, double>, avx512_f64, avx512_int<T>>>;
+    } // namespace
+
+    namespace detail {
+        template <typename T>
+        kernel<T> avx512_kernel(predicate p, source s) {
+            return pick_vector<avx512_ops, T>(p, s);
+        }
+
+        RAVEL_SIMD_INSTANTIATE(avx512_kernel, predicate, source)
+
+        pair_kernel avx512_pair_kernel() {
+            return &find_pair_vector<avx512_int<std::uint8_t>>;
+        }
+    } // namespace detail
+} // namespace core::simd
+
+#endif
@@ -0,0 +1,256 @@
+#pragma once
+
+// shared kernel bodies. only included by simd.cpp and the per-isa translation units, everything
+// lives in an anonymous namespace so code built with different -m flags never gets merged by the linker
+
+#include <bit>
+#include <cstring>
+#include <span>
+
+#include <core/scanner/simd.h>
+
+namespace core::simd {
+    namespace {
+        template <predicate P, typename T>
+        bool match(T val, T rhs, T upper) {
+            if constexpr (P == predicate::eq) {
+                return val == rhs;
+            } else if constexpr (P == predicate::ne) {
+                return val != rhs;
+            } else if constexpr (P == predicate::gt) {
+                return val > rhs;
+            } else if constexpr (P == predicate::lt) {
+                return val < rhs;
+            } else {
+                return rhs <= val && val <= upper;
+            }
+        }
+
+        template <source S, typename T>
+        T rhs_at(T value, const std::byte* previous, std::size_t offset) {
+            if constexpr (S == source::previous) {
+                T val;
+                std::memcpy(&val, previous + offset, sizeof(T));
+                return val;
+            } else {
+                return value;
+            }
+        }
+
+        template <predicate P, source S, typename T>
+        std::size_t scan_scalar(
+                std::span<const std::byte> data, std::size_t offset, std::size_t align, operands<T> args,
+                std::uint32_t* out
+        ) {
+            if (data.size() < sizeof(T))
+                return 0;
+
+            std::size_t count = 0;
+            for (const std::size_t last = data.size() - sizeof(T); offset <= last; offset += align) {
+                T val;
+                std::memcpy(&val, data.data() + offset, sizeof(T));
+                const T rhs = rhs_at<S>(args.value, args.previous, offset);
+                const T upper = P == predicate::between ? rhs_at<S>(args.upper, args.previous_upper, offset) : rhs;
+                if (match<P>(val, rhs, upper)) {
+                    out[count++] = static_cast<std::uint32_t>(offset);
+                }
+            }
+            return count;
+        }
+
+        template <predicate P, source S, typename T>
+        std::size_t
+        scan_reference(std::span<const std::byte> data, std::size_t align, operands<T> args, std::uint32_t* out) {
+            return scan_scalar<P, S>(data, 0, align, args, out);
+        }
+
+        // bit i set for every lane that starts at byte i of a width-byte vector
+        template <typename T>
+        constexpr std::uint64_t lane_starts(std::size_t width) {
+            std::uint64_t mask = 0;
+            for (std::size_t i = 0; i < width; i += sizeof(T)) {
+                mask |= std::uint64_t{1} << i;
+            }
+            return mask;
+        }
+
+        template <typename Ops, predicate P, typename T>
+        std::uint64_t compare(typename Ops::vec val, typename Ops::vec rhs, typename Ops::vec upper) {
+            if constexpr (P == predicate::eq) {
+                return Ops::eq(val, rhs);
+            } else if constexpr (P == predicate::ne) {
+                return Ops::eq(val, rhs) ^ lane_starts<T>(Ops::width);
+            } else if constexpr (P == predicate::gt) {
+                return Ops::gt(val, rhs);
+            } else if constexpr (P == predicate::lt) {
+                return Ops::lt(val, rhs);
+            } else {
+                // spelled as >= and <= rather than negated < and >, so nan stays out of every range
+                return (Ops::gt(val, rhs) | Ops::eq(val, rhs)) & (Ops::lt(val, upper) | Ops::eq(val, upper));
+            }
+        }
+
+        // walks 64 byte blocks, or'ing the per-vector compare masks into one hit mask per block. unaligned
+        // mode repeats the pass once per byte shift so every start offset inside the block is covered
+        template <typename Ops, predicate P, source S, bool Unaligned, typename T>
+        std::size_t scan_blocks(
+                std::span<const std::byte> data, std::size_t& offset, operands<T> args, std::uint32_t* out
+        ) {
+            constexpr std::size_t block = 64;
+            constexpr std::size_t shifts = Unaligned ? sizeof(T) : 1;
+
+            const auto value = Ops::broadcast(args.value);
+            const auto upper = Ops::broadcast(args.upper);
+            const std::byte* base = data.data();
+            std::size_t count = 0;
+
+            for (; offset + block + shifts - 1 <= data.size(); offset += block) {
+                std::uint64_t hits = 0;
+                for (std::size_t k = 0; k < shifts; ++k) {
+                    for (std::size_t v = 0; v < block; v += Ops::width) {
+                        const std::size_t at = offset + k + v;
+                        auto rhs = value;
+                        auto rhs_upper = upper;
+                        if constexpr (S == source::previous) {
+                            rhs = Ops::load(args.previous + at);
+                            if constexpr (P == predicate::between) {
+                                rhs_upper = Ops::load(args.previous_upper + at);
+                            }
+                        }
+                        hits |= compare<Ops, P, T>(Ops::load(base + at), rhs, rhs_upper) << (k + v);
+                    }
+                }
+
+                while (hits != 0) {
+                    const auto bit = static_cast<std::size_t>(std::countr_zero(hits));
+                    out[count++] = static_cast<std::uint32_t>(offset + bit);
+                    hits &= hits - 1;
+                }
+            }
+            return count;
+        }
+
+        template <typename Ops, predicate P, source S, typename T>
+        std::size_t
+        scan_vector(std::span<const std::byte> data, std::size_t align, operands<T> args, std::uint32_t* out) {
+            std::size_t offset = 0;
+            std::size_t count = 0;
+
+            if (align == sizeof(T)) {
+                count = scan_blocks<Ops, P, S, false>(data, offset, args, out);
+            } else if (align == 1) {
+                count = scan_blocks<Ops, P, S, true>(data, offset, args, out);
+            }
+
+            // tail, or any alignment the block loop doesn't handle
+            return count + scan_scalar<P, S>(data, offset, align, args, out + count);
+        }
+
+        template <typename T, source S>
+        kernel<T> pick_reference(predicate p) {
+            switch (p) {
+                case predicate::eq:
+                    return &scan_reference<predicate::eq, S, T>;
+                case predicate::ne:
+                    return &scan_reference<predicate::ne, S, T>;
+                case predicate::gt:
+                    return &scan_reference<predicate::gt, S, T>;
+                case predicate::lt:
+                    return &scan_reference<predicate::lt, S, T>;
+                case predicate::between:
+                    return &scan_reference<predicate::between, S, T>;
+            }
+            return nullptr;
+        }
+
+        template <typename T>
+        kernel<T> pick_reference(predicate p, source s) {
+            if (s == source::previous) {
+                return pick_reference<T, source::previous>(p);
+            }
+            return pick_reference<T, source::constant>(p);
+        }
+
+        template <typename Ops, typename T, source S>
+        kernel<T> pick_vector(predicate p) {
+            switch (p) {
+                case predicate::eq:
+                    return &scan_vector<Ops, predicate::eq, S, T>;
+                case predicate::ne:
+                    return &scan_vector<Ops, predicate::ne, S, T>;
+                case predicate::gt:
+                    return &scan_vector<Ops, predicate::gt, S, T>;
+                case predicate::lt:
+                    return &scan_vector<Ops, predicate::lt, S, T>;
+                case predicate::between:
+                    return &scan_vector<Ops, predicate::between, S, T>;
+            }
+            return nullptr;
+        }
+
+        template <template <typename> typename Ops, typename T>
+        kernel<T> pick_vector(predicate p, source s) {
+            if (s == source::previous) {
+                return pick_vector<Ops<T>, T, source::previous>(p);
+            }
+            return pick_vector<Ops<T>, T, source::constant>(p);
+        }
+
+        inline std::size_t
+        find_pair_scalar(std::span<const std::byte> data, std::size_t offset, byte_pair pair, std::uint32_t* out) {
+            const auto first = static_cast<std::byte>(pair.first);
+            const auto last = static_cast<std::byte>(pair.last);
+
+            std::size_t count = 0;
+            for (; offset + pair.last_at < data.size(); ++offset) {
+                if (data[offset + pair.first_at] == first && data[offset + pair.last_at] == last) {
+                    out[count++] = static_cast<std::uint32_t>(offset);
+                }
+            }
+            return count;
+        }
+
+        // same 64 byte blocks as scan_blocks, with the two byte compares and'ed before they become hits. two
+        // bytes far apart in the pattern rule out nearly every offset without touching the rest of it
+        template <typename Ops>
+        std::size_t find_pair_vector(std::span<const std::byte> data, byte_pair pair, std::uint32_t* out) {
+            constexpr std::size_t block = 64;
+
+            const auto first = Ops::broadcast(pair.first);
+            const auto last = Ops::broadcast(pair.last);
+            const std::byte* base = data.data();
+            std::size_t offset = 0;
+            std::size_t count = 0;
+
+            for (; offset + block + pair.last_at <= data.size(); offset += block) {
+                std::uint64_t hits = 0;
+                for (std::size_t v = 0; v < block; v += Ops::width) {
+                    const std::byte* at = base + offset + v;
+                    hits |= (Ops::eq(Ops::load(at + pair.first_at), first) &
+                             Ops::eq(Ops::load(at + pair.last_at), last))
+                            << v;
+                }
+
+                while (hits != 0) {
+                    const auto bit = static_cast<std::size_t>(std::countr_zero(hits));
+                    out[count++] = static_cast<std::uint32_t>(offset + bit);
+                    hits &= hits - 1;
+                }
+            }
+
+            return count + find_pair_scalar(data, offset, pair, out + count);
+        }
+    } // namespace
+} // namespace core::simd
+
+#define RAVEL_SIMD_INSTANTIATE(fn, ...)                                                                                \
+    template kernel<std::uint8_t> fn<std::uint8_t>(__VA_ARGS__);                                                       \
+    template kernel<std::int8_t> fn<std::int8_t>(__VA_ARGS__);                                                         \
+    template kernel<std::uint16_t> fn<std::uint16_t>(__VA_ARGS__);                                                     \
+    template kernel<std::int16_t> fn<std::int16_t>(__VA_ARGS__);                                                       \
+    template kernel<std::uint32_t> fn<std::uint32_t>(__VA_ARGS__);                                                     \
+    template kernel<std::int32_t> fn<std::int32_t>(__VA_ARGS__);                                                       \
+    template kernel<std::uint64_t> fn<std::uint64_t>(__VA_ARGS__);                                                     \
+    template kernel<std::int64_t> fn<std::int64_t>(__VA_ARGS__);                                                       \
+    template kernel<float> fn<float>(__VA_ARGS__);                                                                     \
+    template kernel<double> fn<double>(__VA_ARGS__);
@@ -0,0 +1,171 @@
+#include <core/scanner/simd.h>
+
+#if defined(RAVEL_SIMD_X86)
+
+#include <core/scanner/simd_kernels.h>
+
+#include <type_traits>
+
+#include <immintrin.h>
+
+namespace core::simd {
+    namespace {
+        template <typename T>
+        struct sse2_int {
+            using vec = __m128i;
+            static constexpr std::size_t width = 16;
+            static constexpr std::uint64_t starts = lane_starts<T>(width);
+
+            static vec load(const std::byte* p) {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            }
+
+            static vec broadcast(T v) {
+                if constexpr (sizeof(T) == 1) {
+                    return _mm_set1_epi8(static_cast<char>(v));
+                } else if constexpr (sizeof(T) == 2) {
+                    return _mm_set1_epi16(static_cast<short>(v));
+                } else if constexpr (sizeof(T) == 4) {
+                    return _mm_set1_epi32(static_cast<int>(v));
+                } else {
+                    return _mm_set1_epi64x(static_cast<long long>(v));
+                }
+            }
+
+            static std::uint64_t mask(vec m) {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(m)) & starts;
+            }
+
+            // unsigned compares go through the signed instructions with the sign bit flipped
+            static vec to_signed(vec v) {
+                if constexpr (std::is_signed_v<T>) {
+                    return v;
+                } else {
+                    return _mm_xor_si128(v, broadcast(static_cast<T>(T{1} << (sizeof(T) * 8 - 1))));
+                }
+            }
+
+            static vec cmpeq(vec a, vec b) {
+                if constexpr (sizeof(T) == 1) {
+                    return _mm_cmpeq_epi8(a, b);
+                } else if constexpr (sizeof(T) == 2) {
+                    return _mm_cmpeq_epi16(a, b);
+                } else if constexpr (sizeof(T) == 4) {
+                    return _mm_cmpeq_epi32(a, b);
+                } else {
+                    // no pcmpeqq before sse4.1, both dword halves have to match
+                    const vec halves = _mm_cmpeq_epi32(a, b);
+                    return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+                }
+            }
+
+            static vec cmpgt(vec a, vec b) {
+                if constexpr (sizeof(T) == 1) {
+                    return _mm_cmpgt_epi8(a, b);
+                } else if constexpr (sizeof(T) == 2) {
+                    return _mm_cmpgt_epi16(a, b);
+                } else if constexpr (sizeof(T) == 4) {
+                    return _mm_cmpgt_epi32(a, b);
+                } else {
+                    // high dwords decide unless equal, then the borrow of b - a carries the low dword compare
+                    const vec high = _mm_or_si128(
+                            _mm_cmpgt_epi32(a, b), _mm_and_si128(_mm_cmpeq_epi32(a, b), _mm_sub_epi64(b, a))
+                    );
+                    return _mm_srai_epi32(_mm_shuffle_epi32(high, _MM_SHUFFLE(3, 3, 1, 1)), 31);
+                }
+            }
+
+            static std::uint64_t eq(vec a, vec b) {
+                return mask(cmpeq(a, b));
+            }
+
+            static std::uint64_t gt(vec a, vec b) {
+                return mask(cmpgt(to_signed(a), to_signed(b)));
+            }
+
+            static std::uint64_t lt(vec a, vec b) {
+                return gt(b, a);
+            }
+        };
+
+        struct sse2_f32 {
+            using vec = __m128;
+            static constexpr std::size_t width = 16;
+            static constexpr std::uint64_t starts = lane_starts<float>(width);
+
+            static vec load(const std::byte* p) {
+                return _mm_loadu_ps(reinterpret_cast<const float*>(p));
+            }
+
+            static vec broadcast(float v) {
+                return _mm_set1_ps(v);
+            }
+
+            static std::uint64_t mask(vec m) {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_castps_si128(m))) & starts;
+            }
+
+            static std::uint64_t eq(vec a, vec b) {
+                return mask(_mm_cmpeq_ps(a, b));
+            }
+
+            static std::uint64_t gt(vec a, vec b) {
+                return mask(_mm_cmpgt_ps(a, b));
+            }
+
+            static std::uint64_t lt(vec a, vec b) {
+                return mask(_mm_cmplt_ps(a, b));
+            }
+        };
+
+        struct sse2_f64 {
+            using vec = __m128d;
+            static constexpr std::size_t width = 16;
+            static constexpr std::uint64_t starts = lane_starts<double>(width);
+
+            static vec load(const std::byte* p) {
+                return _mm_loadu_pd(reinterpret_cast<const double*>(p));
+            }
+
+            static vec broadcast(double v) {
+                return _mm_set1_pd(v);
+            }
+
+            static std::uint64_t mask(vec m) {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_castpd_si128(m))) & starts;
+            }
+
+            static std::uint64_t eq(vec a, vec b) {
+                return mask(_mm_cmpeq_pd(a, b));
+            }
+
+            static std::uint64_t gt(vec a, vec b) {
+                return mask(_mm_cmpgt_pd(a, b));
+            }
+
+            static std::uint64_t lt(vec a, vec b) {
+                return mask(_mm_cmplt_pd(a, b));
+            }
+        };
+
+        template <typename T>
+        using sse2_ops = std::conditional_t<
+                std::is_same_v<T, float>, sse2_f32,
+                std::conditional_t<std::is_same_v<T, double>, sse2_f64, sse2_int<T>>>;
+    } // namespace
+
+    namespace detail {
+        template <typename T>
+        kernel<T> sse2_kernel(predicate p, source s) {
+            return pick_vector<sse2_ops, T>(p, s);
+        }
+
+        RAVEL_SIMD_INSTANTIATE(sse2_kernel, predicate, source)
+
+        pair_kernel sse2_pair_kernel() {
+            return &find_pair_vector<sse2_int<std::uint8_t>>;
+        }
+    } // namespace detail
+} // namespace core::simd
+
+#endif
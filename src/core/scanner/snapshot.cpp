@@ -0,0 +1,221 @@
+#include <core/scanner/snapshot.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include "util/mapped_file.h"
+
+namespace core {
+    namespace {
+        constexpr std::size_t chunk_bytes = 16 * 1024 * 1024;
+
+        std::uint64_t hash_block(std::span<const std::byte> block) {
+            std::uint64_t h = 0x9e3779b97f4a7c15ull ^ block.size();
+            std::size_t i = 0;
+            for (; i + sizeof(std::uint64_t) <= block.size(); i += sizeof(std::uint64_t)) {
+                std::uint64_t word;
+                std::memcpy(&word, block.data() + i, sizeof(word));
+                h = (h ^ word) * 0xff51afd7ed558ccdull;
+                h ^= h >> 32;
+            }
+            for (; i < block.size(); ++i) {
+                h = (h ^ static_cast<std::uint64_t>(block[i])) * 0xff51afd7ed558ccdull;
+            }
+            return h;
+        }
+    } // namespace
+
+    // fixed size blocks with content dedup, backed by the scratch file when one can be made and the heap otherwise.
+    // blocks go to a shard picked by their hash, each with its own lock, index and chunks, so workers storing pages
+    // at the same time rarely wait on each other. a slot names its shard in the low bits
+    class snapshot::block_store {
+    public:
+        explicit block_store(std::size_t block_size) :
+            m_block_size(block_size), m_blocks_per_chunk(chunk_bytes / block_size) {
+        }
+
+        std::uint32_t insert(std::span<const std::byte> block) {
+            const std::uint64_t h = hash_block(block);
+            const auto shard_idx = static_cast<std::uint32_t>(h >> (64 - shard_bits));
+            auto& s = m_shards[shard_idx];
+            const auto tag = static_cast<std::uint32_t>(h);
+
+            std::lock_guard lock(s.mutex);
+            if ((s.used + 1) * 4 > s.index.size() * 3) {
+                rehash(s);
+            }
+
+            // linear probing from the low half of the hash. entries keep it, so most mismatches are told apart and
+            // the index grows without touching the blocks
+            const std::size_t mask = s.index.size() - 1;
+            std::size_t at = tag & mask;
+            for (; s.index[at].slot != empty; at = (at + 1) & mask) {
+                const auto& e = s.index[at];
+                if (e.tag == tag && std::memcmp(block_at(s, e.slot), block.data(), m_block_size) == 0) {
+                    return e.slot << shard_bits | shard_idx;
+                }
+            }
+
+            if (s.count == s.chunks.size() * m_blocks_per_chunk) {
+                s.chunks.push_back(new_chunk());
+            }
+
+            const auto local = static_cast<std::uint32_t>(s.count++);
+            std::memcpy(block_at(s, local), block.data(), m_block_size);
+            s.index[at] = {tag, local};
+            ++s.used;
+            return local << shard_bits | shard_idx;
+        }
+
+        // slots of a shard still taking blocks may only be read by the thread holding its lock
+        [[nodiscard]] const std::byte* get(std::uint32_t slot) const {
+            return block_at(m_shards[slot & (shard_count - 1)], slot >> shard_bits);
+        }
+
+        [[nodiscard]] std::size_t bytes() const {
+            std::size_t count = 0;
+            for (const auto& s : m_shards) {
+                std::lock_guard lock(s.mutex);
+                count += s.count;
+            }
+            return count * m_block_size;
+        }
+
+    private:
+        static constexpr std::uint32_t shard_bits = 4;
+        static constexpr std::uint32_t shard_count = 1u << shard_bits;
+        static constexpr std::uint32_t empty = UINT32_MAX;
+
+        struct entry {
+            std::uint32_t tag = 0;
+            std::uint32_t slot = empty; // within the shard
+        };
+
+        struct alignas(64) shard {
+            mutable std::mutex mutex;
+            std::vector<entry> index; // power of two sized, at most three quarters used
+            std::size_t used = 0;
+            std::vector<std::byte*> chunks;
+            std::size_t count = 0;
+        };
+
+        [[nodiscard]] std::byte* block_at(const shard& s, std::uint32_t local) const {
+            return s.chunks[local / m_blocks_per_chunk] + (local % m_blocks_per_chunk) * m_block_size;
+        }
+
+        static void rehash(shard& s) {
+            std::vector<entry> grown(std::max<std::size_t>(s.index.size() * 2, 1024));
+            const std::size_t mask = grown.size() - 1;
+            for (const auto& e : s.index) {
+                if (e.slot == empty)
+                    continue;
+                std::size_t at = e.tag & mask;
+                while (grown[at].slot != empty) {
+                    at = (at + 1) & mask;
+                }
+                grown[at] = e;
+            }
+            s.index = std::move(grown);
+        }
+
+        // chunks come from one backing shared by the shards, taken whole by whichever shard runs out
+        std::byte* new_chunk() {
+            std::lock_guard lock(m_backing_mutex);
+            if (!m_file && !m_file_failed) {
+                if (auto file = scratch_file::create()) {
+                    m_file.emplace(std::move(*file));
+                } else {
+                    m_file_failed = true;
+                }
+            }
+
+            if (m_file) {
+                if (auto region = m_file->extend(chunk_bytes)) {
+                    m_mapped.push_back(std::move(*region));
+                    return m_mapped.back().bytes().data();
+                }
+            }
+
+            m_heap.push_back(std::make_unique_for_overwrite<std::byte[]>(chunk_bytes));
+            return m_heap.back().get();
+        }
+
+        std::size_t m_block_size;
+        std::size_t m_blocks_per_chunk;
+        std::array<shard, shard_count> m_shards;
+
+        std::mutex m_backing_mutex;
+        std::optional<scratch_file> m_file;
+        bool m_file_failed = false;
+        std::vector<mapped_region> m_mapped;
+        std::vector<std::unique_ptr<std::byte[]>> m_heap;
+    };
+
+    snapshot::snapshot(std::size_t align) :
+        m_align(align), m_pages(std::make_unique<block_store>(page_size)),
+        m_masks(std::make_unique<block_store>(mask_words() * sizeof(std::uint64_t))) {
+    }
+
+    snapshot::~snapshot() = default;
+
+    snapshot::snapshot(snapshot&& other) noexcept :
+        m_align(other.m_align), m_regions(std::move(other.m_regions)), m_pages(std::move(other.m_pages)),
+        m_masks(std::move(other.m_masks)), m_candidates(other.m_candidates.load()) {
+    }
+
+    snapshot& snapshot::operator=(snapshot&& other) noexcept {
+        m_align = other.m_align;
+        m_regions = std::move(other.m_regions);
+        m_pages = std::move(other.m_pages);
+        m_masks = std::move(other.m_masks);
+        m_candidates = other.m_candidates.load();
+        return *this;
+    }
+
+    snapshot::region& snapshot::add_region(std::uintptr_t base, std::size_t size) {
+        auto& r = m_regions.emplace_back();
+        r.base = base;
+        r.size = size;
+        r.pages.resize((size + page_size - 1) / page_size);
+        return r;
+    }
+
+    std::uint32_t snapshot::store_data(std::span<const std::byte> data) {
+        if (data.size() >= page_size) {
+            return m_pages->insert(data.first(page_size));
+        }
+
+        std::array<std::byte, page_size> padded{};
+        std::memcpy(padded.data(), data.data(), data.size());
+        return m_pages->insert(padded);
+    }
+
+    std::uint32_t snapshot::store_mask(std::span<const std::uint64_t> mask) {
+        return m_masks->insert(std::as_bytes(mask));
+    }
+
+    const std::byte* snapshot::data(std::uint32_t slot) const {
+        return m_pages->get(slot);
+    }
+
+    const std::uint64_t* snapshot::mask(std::uint32_t slot) const {
+        return reinterpret_cast<const std::uint64_t*>(m_masks->get(slot));
+    }
+
+    bool snapshot::is_candidate(const page& p, std::size_t page_offset) const {
+        if (p.mask == none)
+            return false;
+        if (p.mask == all)
+            return true;
+
+        const std::size_t slot = page_offset / m_align;
+        return (mask(p.mask)[slot / 64] >> (slot % 64)) & 1;
+    }
+
+    std::size_t snapshot::stored_bytes() const {
+        return m_pages->bytes() + m_masks->bytes();
+    }
+} // namespace core
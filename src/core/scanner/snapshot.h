@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace core {
+    // page granular copy of target memory for scans that compare against earlier contents instead of a typed in
+    // value. identical pages are kept once and live in an unlinked scratch file, so a snapshot of a large heap
+    // costs disk space and page cache rather than resident memory. candidates are never listed one by one, each
+    // page carries a bitmap over its align sized slots, deduplicated the same way
+    class snapshot {
+    public:
+        static constexpr std::size_t page_size = 0x1000;
+
+        static constexpr std::uint32_t none = UINT32_MAX;    // data: not copied, mask: no candidates
+        static constexpr std::uint32_t all = UINT32_MAX - 1; // mask: every slot is a candidate
+
+        struct page {
+            std::uint32_t data = none;
+            std::uint32_t mask = none;
+        };
+
+        struct region {
+            std::uintptr_t base = 0;
+            std::size_t size = 0;
+            std::vector<page> pages;
+        };
+
+        explicit snapshot(std::size_t align);
+        ~snapshot();
+
+        snapshot(snapshot&& other) noexcept;
+        snapshot& operator=(snapshot&& other) noexcept;
+        snapshot(const snapshot&) = delete;
+        snapshot& operator=(const snapshot&) = delete;
+
+        [[nodiscard]] std::size_t align() const {
+            return m_align;
+        }
+
+        [[nodiscard]] std::size_t slots_per_page() const {
+            return page_size / m_align;
+        }
+
+        // adds a region with every page uncopied, only safe before any worker touches the snapshot
+        region& add_region(std::uintptr_t base, std::size_t size);
+
+        [[nodiscard]] std::span<region> regions() {
+            return m_regions;
+        }
+
+        [[nodiscard]] std::span<const region> regions() const {
+            return m_regions;
+        }
+
+        // store a page or a candidate mask and return its slot, reusing an identical one when there is one. safe
+        // to call from several threads. data shorter than a page is zero padded
+        std::uint32_t store_data(std::span<const std::byte> data);
+        std::uint32_t store_mask(std::span<const std::uint64_t> mask);
+
+        [[nodiscard]] const std::byte* data(std::uint32_t slot) const;
+        [[nodiscard]] const std::uint64_t* mask(std::uint32_t slot) const;
+
+        [[nodiscard]] std::size_t mask_words() const {
+            return (slots_per_page() + 63) / 64;
+        }
+
+        [[nodiscard]] bool is_candidate(const page& p, std::size_t page_offset) const;
+
+        void add_candidates(std::size_t count) {
+            m_candidates.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::size_t candidate_count() const {
+            return m_candidates.load(std::memory_order_relaxed);
+        }
+
+        // bytes taken by unique pages and masks
+        [[nodiscard]] std::size_t stored_bytes() const;
+
+    private:
+        class block_store;
+
+        std::size_t m_align;
+        std::vector<region> m_regions;
+        std::unique_ptr<block_store> m_pages;
+        std::unique_ptr<block_store> m_masks;
+        std::atomic<std::size_t> m_candidates = 0;
+    };
+} // namespace core
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <expected>
 #include <memory>
@@ -8,16 +9,25 @@
 #include <string>
 #include <vector>
 
+#include <core/io_budget.h>
+#include <core/region_table.h>
 #include <util/expected.h>
+#include <util/mapped_file.h>
 
 namespace core {
-    struct memory_region {
-        std::uintptr_t base_address;
-        std::size_t size;
-        std::string permission;
-        std::string name;
+    struct read_request {
+        std::uintptr_t address;
+        std::span<std::byte> buffer;
+    };
+
+    struct write_request {
+        std::uintptr_t address;
+        std::span<const std::byte> buffer;
+    };
 
-        auto operator<=>(const memory_region&) const = default;
+    struct memory_run {
+        std::uintptr_t address;
+        std::size_t size;
     };
 
     class target {
@@ -26,11 +36,113 @@ namespace core {
 
         [[nodiscard]] virtual std::expected<void, error_code>
         read_memory(std::uintptr_t address, std::span<std::byte> buffer) = 0;
+        // reads every request it can and returns how many were filled completely. readable, when given, gets 1 for
+        // those and 0 for the rest. a request that faults doesn't stop the ones after it, live backends carry many
+        // requests per syscall
+        virtual std::size_t
+        read_memory_batch(std::span<const read_request> requests, std::span<std::uint8_t> readable = {}) = 0;
+        // the calls a read_memory_batch of that many requests makes at the least, what a budget charges for it
+        [[nodiscard]] virtual std::size_t batch_calls(std::size_t requests) const {
+            return requests;
+        }
+        // reads as much of the front of [address, address + size) as it can and returns how many bytes that was
+        [[nodiscard]] virtual std::size_t read_prefix(std::uintptr_t address, std::span<std::byte> buffer) {
+            return read_memory(address, buffer) ? buffer.size() : 0;
+        }
         [[nodiscard]] virtual std::expected<void, error_code>
         write_memory(std::uintptr_t address, std::span<const std::byte> buffer) = 0;
+        // writes requests in order and returns how many leading requests were written completely
+        [[nodiscard]] virtual std::size_t write_memory_batch(std::span<const write_request> requests) {
+            std::size_t done = 0;
+            while (done < requests.size() && write_memory(requests[done].address, requests[done].buffer)) {
+                ++done;
+            }
+            return done;
+        }
+        // the bytes of [address, address + size) in place, for targets that keep them contiguous in their own
+        // memory. the span stays valid until the target is changed or destroyed. live targets never lend, and
+        // nothing is lent when any part of the range would have to be read some other way
+        [[nodiscard]] virtual std::optional<std::span<const std::byte>> view_memory(std::uintptr_t, std::size_t) {
+            return std::nullopt;
+        }
+        // the runs of [address, address + size) that can hold anything but zeros. targets that know parts are zero
+        // filled without reading them leave those out, the rest give back the whole range
+        virtual void data_runs(std::uintptr_t address, std::size_t size, std::vector<memory_run>& runs) {
+            runs.assign(1, {address, size});
+        }
+        // how [address, address + size) is about to be read, for targets whose bytes the os pages in on their own
+        virtual void advise(std::uintptr_t, std::size_t, access_pattern) {
+        }
         [[nodiscard]] virtual std::expected<std::vector<memory_region>, error_code> get_memory_regions() = 0;
+        // the same regions as a compact table. targets that can tell their regions haven't changed hand the same
+        // table out again, so everything asking for it shares one copy
+        [[nodiscard]] virtual std::expected<std::shared_ptr<const region_table>, error_code> get_region_table() {
+            auto regions = get_memory_regions();
+            if (!regions)
+                return std::unexpected(regions.error());
+            return region_table::from_regions(*regions);
+        }
         [[nodiscard]] virtual bool is_live() const = 0;
         [[nodiscard]] virtual std::string get_name() const = 0;
         [[nodiscard]] virtual std::optional<std::uintptr_t> get_entry_point() const = 0;
+
+        // granularity of the dirty and residency bits
+        static constexpr std::size_t page_size = 0x1000;
+
+        // write tracking for rescans. sync_dirty notes which pages were written since the previous sync and returns
+        // the generation starting now, written_since tells whether a range may have been written after a given
+        // generation. without tracking there is no generation and every range counts as written
+        [[nodiscard]] virtual std::optional<std::uint32_t> sync_dirty() {
+            return std::nullopt;
+        }
+        [[nodiscard]] virtual bool written_since(std::uintptr_t, std::size_t, std::uint32_t) const {
+            return true;
+        }
+
+        // one bit per page of [address, address + size) set when reading it faults nothing in, so pages that are
+        // swapped out, were never touched or only map the shared zero page stay clear. address is page aligned
+        [[nodiscard]] virtual std::expected<void, error_code>
+        resident_pages(std::uintptr_t, std::size_t, std::span<std::uint64_t>) {
+            return std::unexpected(error_code::not_supported);
+        }
+
+        // what the scanner, the strings and the xref scans may read of this target between them. reads anything
+        // else does, like the views showing memory or the freezer, aren't counted
+        [[nodiscard]] io_budget& budget() {
+            return m_budget;
+        }
+
+    private:
+        io_budget m_budget;
     };
+
+    // splits [address, address + size) into the runs of pages t has resident, the whole range when it can't tell.
+    // returns the bytes left out
+    inline std::size_t
+    resident_runs(target& t, std::uintptr_t address, std::size_t size, std::vector<memory_run>& runs) {
+        runs.clear();
+
+        const std::size_t pages = (size + target::page_size - 1) / target::page_size;
+        std::vector<std::uint64_t> bits((pages + 63) / 64);
+        if (!t.resident_pages(address, size, bits)) {
+            runs.push_back({address, size});
+            return 0;
+        }
+
+        std::size_t kept = 0;
+        for (std::size_t page = 0; page < pages; ++page) {
+            if (((bits[page / 64] >> (page % 64)) & 1) == 0)
+                continue;
+
+            const std::uintptr_t start = address + page * target::page_size;
+            const std::size_t length = std::min(target::page_size, size - page * target::page_size);
+            if (!runs.empty() && runs.back().address + runs.back().size == start) {
+                runs.back().size += length;
+            } else {
+                runs.push_back({start, length});
+            }
+            kept += length;
+        }
+        return size - kept;
+    }
 } // namespace core
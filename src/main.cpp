@@ -32,6 +32,7 @@ int main(int argc, char** argv) {
     } else {
         app::active_target = std::make_unique<core::process>();
     }
+    app::page_cache->set_target(app::active_target.get());
 
     if (cli_mode) {
         cli::repl command_line_interface;
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <string>
+
 #include <platform/process_controller.h>
 
 namespace platform {
@@ -16,14 +20,50 @@ namespace platform {
         [[nodiscard]] std::expected<std::vector<core::memory_region>, core::error_code>
         get_memory_regions(std::uint32_t pid) override;
 
+        [[nodiscard]] std::expected<std::shared_ptr<const core::region_table>, core::error_code>
+        get_region_table(std::uint32_t pid) override;
+
         [[nodiscard]] std::expected<void, core::error_code>
         read_memory(std::uint32_t pid, std::uintptr_t address, std::span<std::byte> buffer) override;
 
+        [[nodiscard]] std::size_t
+        read_prefix(std::uint32_t pid, std::uintptr_t address, std::span<std::byte> buffer) override;
+
+        std::size_t read_memory_batch(
+                std::uint32_t pid, std::span<const core::read_request> requests, std::span<std::uint8_t> readable
+        ) override;
+        [[nodiscard]] std::size_t batch_calls(std::size_t requests) const override;
+
         [[nodiscard]] std::expected<void, core::error_code>
         write_memory(std::uint32_t pid, std::uintptr_t address, std::span<const std::byte> buffer) override;
 
+        [[nodiscard]] std::size_t
+        write_memory_batch(std::uint32_t pid, std::span<const core::write_request> requests) override;
+
+        [[nodiscard]] std::expected<void, core::error_code> clear_soft_dirty(std::uint32_t pid) override;
+
+        [[nodiscard]] std::expected<void, core::error_code>
+        read_soft_dirty(std::uint32_t pid, std::uintptr_t address, std::size_t size, std::span<std::uint64_t> bits)
+                override;
+
+        [[nodiscard]] std::expected<void, core::error_code>
+        read_residency(std::uint32_t pid, std::uintptr_t address, std::size_t size, std::span<std::uint64_t> bits)
+                override;
+
     private:
-        // /proc/[pid]/mem
+        // which mappings the mem file may be read in, from the last table handed out when there is one
+        std::shared_ptr<const core::region_table> regions_for_reads(std::uint32_t pid);
+
+        // /proc/[pid]/mem, read with pread for small reads of readable mappings
         int m_mem_fd = -1;
+        // /proc/[pid]/pagemap
+        int m_pagemap_fd = -1;
+
+        // the last /proc/[pid]/maps read and the table parsed from it, handed out again while the text is the same
+        std::mutex m_maps_mutex;
+        std::uint32_t m_maps_pid = 0;
+        std::string m_maps_text;
+        std::string m_maps_scratch;
+        std::shared_ptr<const core::region_table> m_regions;
     };
 } // namespace platform
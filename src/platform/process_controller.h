@@ -2,14 +2,17 @@
 
 #include <cstdint>
 #include <expected>
+#include <memory>
 #include <span>
 #include <vector>
 
+#include <core/region_table.h>
 #include <util/expected.h>
 
 namespace core {
     struct process_info;
-    struct memory_region;
+    struct read_request;
+    struct write_request;
 } // namespace core
 
 namespace platform {
@@ -27,10 +30,56 @@ namespace platform {
         [[nodiscard]] virtual std::expected<std::vector<core::memory_region>, core::error_code>
         get_memory_regions(std::uint32_t pid) = 0;
 
+        // the regions as a table, the previous one again when the controller can tell nothing changed
+        [[nodiscard]] virtual std::expected<std::shared_ptr<const core::region_table>, core::error_code>
+        get_region_table(std::uint32_t pid) {
+            auto regions = get_memory_regions(pid);
+            if (!regions)
+                return std::unexpected(regions.error());
+            return core::region_table::from_regions(*regions);
+        }
+
         [[nodiscard]] virtual std::expected<void, core::error_code>
         read_memory(std::uint32_t pid, std::uintptr_t address, std::span<std::byte> buffer) = 0;
 
+        // reads as much of the front of [address, address + size) as can be read and returns how many bytes that was,
+        // so a range running into an unmapped page still gets the pages before it
+        [[nodiscard]] virtual std::size_t
+        read_prefix(std::uint32_t pid, std::uintptr_t address, std::span<std::byte> buffer) {
+            return read_memory(pid, address, buffer) ? buffer.size() : 0;
+        }
+
+        // reads every request it can and returns how many were read in full. readable, unless empty, gets 1 for
+        // those and 0 for the rest
+        virtual std::size_t read_memory_batch(
+                std::uint32_t pid, std::span<const core::read_request> requests, std::span<std::uint8_t> readable
+        ) = 0;
+        // the calls a read_memory_batch of that many requests makes at the least
+        [[nodiscard]] virtual std::size_t batch_calls(std::size_t requests) const {
+            return requests;
+        }
+
         [[nodiscard]] virtual std::expected<void, core::error_code>
         write_memory(std::uint32_t pid, std::uintptr_t address, std::span<const std::byte> buffer) = 0;
+
+        // returns how many leading requests were written in full
+        [[nodiscard]] virtual std::size_t
+        write_memory_batch(std::uint32_t pid, std::span<const core::write_request> requests) = 0;
+
+        // soft dirty bits, set for every page written since the last clear. bits holds one bit per
+        // core::target::page_size of [address, address + size)
+        [[nodiscard]] virtual std::expected<void, core::error_code> clear_soft_dirty(std::uint32_t) {
+            return std::unexpected(core::error_code::not_supported);
+        }
+        [[nodiscard]] virtual std::expected<void, core::error_code>
+        read_soft_dirty(std::uint32_t, std::uintptr_t, std::size_t, std::span<std::uint64_t>) {
+            return std::unexpected(core::error_code::not_supported);
+        }
+
+        // residency in the same layout, set for pages that can be read without faulting anything in
+        [[nodiscard]] virtual std::expected<void, core::error_code>
+        read_residency(std::uint32_t, std::uintptr_t, std::size_t, std::span<std::uint64_t>) {
+            return std::unexpected(core::error_code::not_supported);
+        }
     };
 } // namespace platform
@@ -209,6 +209,21 @@ namespace platform {
         return {};
     }
 
+    std::size_t windows_controller::read_memory_batch(
+            std::uint32_t pid, std::span<const core::read_request> requests, std::span<std::uint8_t> readable
+    ) {
+        // ReadProcessMemory has no vectored form
+        std::size_t done = 0;
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            const bool read = read_memory(pid, requests[i].address, requests[i].buffer).has_value();
+            if (!readable.empty()) {
+                readable[i] = read;
+            }
+            done += read;
+        }
+        return done;
+    }
+
     std::expected<void, core::error_code>
     windows_controller::write_memory(std::uint32_t /*pid*/, std::uintptr_t address, std::span<const std::byte> buffer) {
         if (!m_process_handle) {
@@ -228,4 +243,17 @@ namespace platform {
         return {};
     }
 
+    std::size_t
+    windows_controller::write_memory_batch(std::uint32_t pid, std::span<const core::write_request> requests) {
+        // WriteProcessMemory has no vectored form either
+        std::size_t done = 0;
+        for (const auto& request : requests) {
+            if (!write_memory(pid, request.address, request.buffer)) {
+                break;
+            }
+            ++done;
+        }
+        return done;
+    }
+
 } // namespace platform
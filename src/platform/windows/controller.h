@@ -27,9 +27,16 @@ namespace platform {
         [[nodiscard]] std::expected<void, core::error_code>
         read_memory(std::uint32_t pid, std::uintptr_t address, std::span<std::byte> buffer) override;
 
+        std::size_t read_memory_batch(
+                std::uint32_t pid, std::span<const core::read_request> requests, std::span<std::uint8_t> readable
+        ) override;
+
         [[nodiscard]] std::expected<void, core::error_code>
         write_memory(std::uint32_t pid, std::uintptr_t address, std::span<const std::byte> buffer) override;
 
+        [[nodiscard]] std::size_t
+        write_memory_batch(std::uint32_t pid, std::span<const core::write_request> requests) override;
+
     private:
         HANDLE m_process_handle = nullptr;
     };
@@ -39,6 +39,8 @@ namespace ui {
         std::string preview = "Select an executable region...";
         if (current_region_idx) {
             const auto& region = executable_regions[*current_region_idx];
+        // the listing jumps around the region as it is scrolled and followed, reading ahead wouldn't pay
+        app::active_target->advise(region.base_address, region.size, core::access_pattern::random);
             preview = std::format(
                     "{} (0x{:X} - 0x{:X})", region.name, region.base_address, region.base_address + region.size
             );
@@ -159,7 +161,8 @@ namespace ui {
     void disassembly_view::update_target_regions() {
         instructions.clear();
         executable_regions.clear();
-        region_data.clear();
+        region_data = {};
+        region_copy.clear();
         scan_offset = 0;
         selected_addr = 0;
         current_region_idx.reset();
@@ -168,14 +171,14 @@ namespace ui {
             return;
         }
 
-        auto regions_result = app::active_target->get_memory_regions();
-        if (!regions_result) {
+        auto table = app::active_target->get_region_table();
+        if (!table) {
             return;
         }
 
-        for (const auto& region : *regions_result) {
-            if (region.permission.find('x') != std::string::npos) {
-                executable_regions.push_back(region);
+        for (const auto& e : (*table)->entries()) {
+            if (e.has(core::perm::exec)) {
+                executable_regions.push_back((*table)->region(e));
             }
         }
     }
@@ -183,7 +186,8 @@ namespace ui {
     void disassembly_view::load_region_data(std::size_t index) {
         current_region_idx = index;
         instructions.clear();
-        region_data.clear();
+        region_data = {};
+        region_copy.clear();
         scan_offset = 0;
         selected_addr = 0;
 
@@ -193,11 +197,18 @@ namespace ui {
 
         const auto& region = executable_regions[*current_region_idx];
 
-        region_data.resize(region.size);
-        auto read_result = app::active_target->read_memory(region.base_address, region_data);
+        // borrowed with an instruction's worth past the end, the decoder reads that far at the last byte
+        const std::size_t reach = region.size + ZYDIS_MAX_INSTRUCTION_LENGTH;
+        if (auto lent = app::active_target->view_memory(region.base_address, reach)) {
+            region_data = lent->first(region.size);
+            return;
+        }
 
-        if (!read_result) {
-            region_data.clear();
+        region_copy.resize(region.size);
+        if (app::active_target->read_memory(region.base_address, region_copy)) {
+            region_data = region_copy;
+        } else {
+            region_copy.clear();
         }
     }
 
@@ -240,7 +251,7 @@ namespace ui {
                     if (abs_addr) {
                         auto string_ref = app::strings->find_exact(static_cast<std::uintptr_t>(*abs_addr));
                         if (string_ref) {
-                            std::string s = app::strings->read_string(app::active_target.get(), *string_ref);
+                            std::string s = app::strings->read_string(app::page_cache.get(), *string_ref);
                             if (s.size() > max_comment_length)
                                 s = s.substr(0, max_comment_length - 3) + "...";
                             instr.comment = s;
@@ -2,6 +2,7 @@
 
 #include <core/target.h>
 #include <optional>
+#include <span>
 #include <string>
 #include <ui/view.h>
 #include <vector>
@@ -38,7 +39,9 @@ namespace ui {
         std::optional<std::size_t> current_region_idx;
         core::target* active_target = nullptr;
 
-        std::vector<std::byte> region_data;
+        // the region's bytes, lent by the target when it holds them itself and read into region_copy otherwise
+        std::span<const std::byte> region_data;
+        std::vector<std::byte> region_copy;
         std::vector<instruction> instructions;
         std::size_t scan_offset = 0;
         std::uintptr_t selected_addr = 0;
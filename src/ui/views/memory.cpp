@@ -98,8 +98,11 @@ namespace ui {
         }
 
         ImGui::SameLine();
-        if (ImGui::Button("Refresh"))
+        // a manual refresh wants what is in memory now, not what the page cache read a moment ago
+        if (ImGui::Button("Refresh")) {
+            app::page_cache->invalidate();
             refresh_cache();
+        }
 
         ImGui::SameLine();
         ImGui::Checkbox("Auto", &auto_refresh);
@@ -242,24 +245,19 @@ namespace ui {
         if (!blk.base)
             return;
 
+        // a block running past the end of a mapping still shows the fields before it
         cache.resize(blk.size);
-        if (target->read_memory(blk.base, cache)) {
-            cache_valid = true;
-        } else {
-            cache.clear();
-        }
+        cache.resize(app::page_cache->read_prefix(blk.base, cache));
+        cache_valid = !cache.empty();
 
         for (auto& f : blk.fields) {
             f.valid = cache_valid && (f.offset + f.size <= cache.size());
-            if (f.valid) {
-                f.meta = resolve_ptr(read_field(f));
-            } else {
-                f.meta.reset();
-            }
         }
 
         if (blk.fields.empty()) {
             update_layout(0);
+        } else {
+            resolve_ptrs(0);
         }
     }
 
@@ -283,13 +281,11 @@ namespace ui {
                 f.size = blk.size - off;
 
             f.valid = cache_valid && (off + f.size <= cache.size());
-            if (f.valid) {
-                f.meta = resolve_ptr(read_field(f));
-            }
 
             blk.fields.push_back(f);
             off += f.size;
         }
+        resolve_ptrs(start_idx);
     }
 
     void memory_view::set_field_type(std::size_t idx, type_id type) {
@@ -306,13 +302,10 @@ namespace ui {
             }
 
             blk.fields[idx].valid = cache_valid && (blk.fields[idx].offset + blk.fields[idx].size <= cache.size());
-            if (blk.fields[idx].valid) {
-                blk.fields[idx].meta = resolve_ptr(read_field(blk.fields[idx]));
-            } else {
-                blk.fields[idx].meta.reset();
-            }
 
+            // the fields after it are laid out again and resolved with it
             update_layout(idx + 1);
+            resolve_ptrs(idx, idx + 1);
         }
     }
 
@@ -378,28 +371,57 @@ namespace ui {
         return out;
     }
 
-    std::optional<std::string> memory_view::resolve_ptr(std::span<const std::byte> data) {
-        if (!target || data.size() < 4)
-            return std::nullopt;
+    void memory_view::resolve_ptrs(std::size_t first, std::size_t last) {
+        if (!active_idx)
+            return;
+        auto& fields = blocks[*active_idx]->fields;
+        last = std::min(last, fields.size());
+
+        // every field that holds a pointer has the text it points at read in one batch
+        constexpr std::size_t text_size = 64;
+        std::vector<std::size_t> owners;
+        std::vector<core::read_request> requests;
+        std::vector<char> text;
+
+        for (std::size_t i = first; i < last; ++i) {
+            auto& f = fields[i];
+            f.meta.reset();
+
+            const auto data = read_field(f);
+            if (!target || data.size() < 4)
+                continue;
+            const uintptr_t ptr = (data.size() == 8) ? cast_bytes<uint64_t>(data) : cast_bytes<uint32_t>(data);
+            if (ptr < 0x1000)
+                continue;
+
+            owners.push_back(i);
+            requests.push_back({ptr, {}});
+        }
+        if (requests.empty())
+            return;
+
+        text.resize(requests.size() * text_size);
+        for (std::size_t k = 0; k < requests.size(); ++k) {
+            requests[k].buffer = std::as_writable_bytes(std::span(text).subspan(k * text_size, text_size));
+        }
+
+        std::vector<std::uint8_t> readable(requests.size());
+        app::page_cache->read_memory_batch(requests, readable);
 
-        uintptr_t ptr = (data.size() == 8) ? cast_bytes<uint64_t>(data) : cast_bytes<uint32_t>(data);
-        if (ptr < 0x1000)
-            return std::nullopt;
+        for (std::size_t k = 0; k < requests.size(); ++k) {
+            if (!readable[k])
+                continue;
 
-        char buf[64];
-        if (auto res = target->read_memory(ptr, std::as_writable_bytes(std::span(buf)))) {
-            buf[63] = 0;
-            std::string_view sv(buf);
+            std::string_view sv(text.data() + k * text_size, text_size - 1);
             if (auto end = sv.find('\0'); end != std::string_view::npos)
                 sv = sv.substr(0, end);
 
             if (!sv.empty() && std::ranges::all_of(sv, [](char c) {
                     return std::isprint(c);
                 })) {
-                return std::string(sv);
+                fields[owners[k]].meta = std::string(sv);
             }
         }
-        return std::nullopt;
     }
 
     size_t memory_view::type_size(type_id t) {
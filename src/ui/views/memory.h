@@ -67,7 +67,8 @@ namespace ui {
         [[nodiscard]] static std::string fmt_hex(std::span<const std::byte> data);
         [[nodiscard]] static std::string fmt_txt(std::span<const std::byte> data);
 
-        [[nodiscard]] std::optional<std::string> resolve_ptr(std::span<const std::byte> data);
+        // fields [first, last) of the active block that point at text get it as their meta
+        void resolve_ptrs(std::size_t first, std::size_t last = SIZE_MAX);
         [[nodiscard]] static std::size_t type_size(type_id type);
         [[nodiscard]] static const char* type_name(type_id type);
 
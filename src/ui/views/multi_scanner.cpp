@@ -0,0 +1,331 @@
+#include <ui/views/multi_scanner.h>
+
+#include <algorithm>
+#include <format>
+#include <ui/theme.h>
+#include <ui/views/scanner.h>
+
+namespace ui {
+    multi_scanner_view::multi_scanner_view() : view("Multi Scan") {
+    }
+
+    void multi_scanner_view::render() {
+        if (ImGui::BeginChild("Processes", ImVec2(260.0f, 0), true)) {
+            draw_processes();
+        }
+        ImGui::EndChild();
+
+        ImGui::SameLine();
+
+        if (ImGui::BeginChild("Scan", ImVec2(260.0f, 0), true)) {
+            draw_config();
+        }
+        ImGui::EndChild();
+
+        ImGui::SameLine();
+
+        if (ImGui::BeginChild("Instances", ImVec2(0, 0), true)) {
+            draw_instances();
+            ImGui::Separator();
+            draw_results();
+        }
+        ImGui::EndChild();
+    }
+
+    void multi_scanner_view::draw_processes() {
+        if (ImGui::Button("Refresh")) {
+            if (auto result = lister.enumerate_processes()) {
+                processes = std::move(*result);
+            } else {
+                processes.clear();
+            }
+            checked.clear();
+        }
+        ImGui::SameLine();
+        filter.Draw("##multi_filter", ImGui::GetContentRegionAvail().x);
+
+        // the filter can tick every process it matches, attaching takes whatever is ticked
+        ImGui::BeginDisabled(engine.is_scanning());
+        if (ImGui::Button("Attach Checked")) {
+            attach_message.clear();
+            std::size_t failed = 0;
+            for (const auto pid : checked) {
+                if (!engine.add(pid)) {
+                    ++failed;
+                }
+            }
+            if (failed > 0) {
+                attach_message = std::format("{} could not be attached.", failed);
+            }
+            checked.clear();
+            is_first_scan = true;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Check Matching")) {
+            for (const auto& p : processes) {
+                if (filter.IsActive() && filter.PassFilter(p.name.c_str())) {
+                    checked.insert(p.pid);
+                }
+            }
+        }
+        ImGui::EndDisabled();
+
+        if (!attach_message.empty()) {
+            ImGui::TextColored(theme::colors::red, "%s", attach_message.c_str());
+        }
+
+        if (ImGui::BeginChild("ProcessList")) {
+            for (const auto& p : processes) {
+                if (!filter.PassFilter(p.name.c_str()))
+                    continue;
+
+                bool is_checked = checked.contains(p.pid);
+                if (ImGui::Checkbox(std::format("{} {}", p.pid, p.name).c_str(), &is_checked)) {
+                    if (is_checked) {
+                        checked.insert(p.pid);
+                    } else {
+                        checked.erase(p.pid);
+                    }
+                }
+            }
+        }
+        ImGui::EndChild();
+    }
+
+    void multi_scanner_view::draw_config() {
+        ImGui::Text("Scan Configuration");
+        ImGui::Separator();
+
+        // groups need their fields laid out, that stays with the single process scanner
+        const auto data_type = static_cast<core::scan_data_type>(selected_type_idx);
+        const bool is_pattern = data_type == core::scan_data_type::bytes;
+        auto type_allowed = [](int idx) {
+            return static_cast<core::scan_data_type>(idx) != core::scan_data_type::group;
+        };
+        auto mode_allowed = [&](int idx) {
+            const auto type = static_cast<core::scan_compare_type>(idx);
+            if (is_pattern)
+                return type == core::scan_compare_type::exact;
+            if (data_type == core::scan_data_type::numeric && type == core::scan_compare_type::unknown)
+                return false;
+            return is_first_scan ? !core::scanner::is_relative(type) : type != core::scan_compare_type::unknown;
+        };
+        if (!mode_allowed(selected_cmp_idx)) {
+            selected_cmp_idx = 0;
+        }
+
+        const auto cmp_type = static_cast<core::scan_compare_type>(selected_cmp_idx);
+        ImGui::BeginDisabled(!core::scanner::needs_value(cmp_type));
+        ImGui::InputText("Value", val_buf, sizeof(val_buf));
+        ImGui::EndDisabled();
+
+        if (ImGui::BeginCombo("Type", type_names[selected_type_idx])) {
+            for (int i = 0; i < IM_ARRAYSIZE(type_names); i++) {
+                if (!type_allowed(i))
+                    continue;
+                if (ImGui::Selectable(type_names[i], i == selected_type_idx)) {
+                    selected_type_idx = i;
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        if (ImGui::BeginCombo("Mode", cmp_names[selected_cmp_idx])) {
+            for (int i = 0; i < IM_ARRAYSIZE(cmp_names); i++) {
+                if (!mode_allowed(i))
+                    continue;
+                if (ImGui::Selectable(cmp_names[i], i == selected_cmp_idx)) {
+                    selected_cmp_idx = i;
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        ImGui::Checkbox("Fast Scan (Aligned)", &config.fast_scan);
+        if (ImGui::Checkbox("Intersect After Scans", &intersect)) {
+            engine.set_intersect(intersect);
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Keep only results at the same module relative offset in every instance");
+        }
+
+        ImGui::Spacing();
+        ImGui::Separator();
+        ImGui::Spacing();
+
+        config.data_type = data_type;
+        config.compare_type = cmp_type;
+        config.value_str = val_buf;
+
+        if (engine.is_scanning()) {
+            const float p = engine.progress();
+            ImGui::ProgressBar(p, ImVec2(-1, 20), std::format("{:.1f}%", p * 100).c_str());
+            if (ImGui::Button("Cancel Scan", ImVec2(-1, 30))) {
+                engine.cancel();
+            }
+            return;
+        }
+
+        ImGui::BeginDisabled(engine.instance_count() == 0);
+        if (is_first_scan) {
+            if (ImGui::Button("First Scan", ImVec2(-1, 30))) {
+                engine.begin_first_scan(config);
+                is_first_scan = false;
+            }
+        } else {
+            ImGui::BeginDisabled(is_pattern);
+            if (ImGui::Button("Next Scan", ImVec2(-1, 30))) {
+                engine.begin_next_scan(config);
+            }
+            ImGui::EndDisabled();
+            ImGui::BeginDisabled(engine.instance_count() < 2);
+            if (ImGui::Button("Intersect Now", ImVec2(-1, 0))) {
+                engine.begin_intersect();
+            }
+            ImGui::EndDisabled();
+            ImGui::Spacing();
+            if (ImGui::Button("Reset / New Scan", ImVec2(-1, 0))) {
+                engine.reset();
+                is_first_scan = true;
+            }
+        }
+        ImGui::EndDisabled();
+    }
+
+    void multi_scanner_view::draw_instances() {
+        const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable;
+
+        const auto counts = engine.hit_counts();
+        std::optional<std::uint32_t> detach;
+        if (ImGui::BeginTable("InstanceTable", 4, flags)) {
+            ImGui::TableSetupColumn("PID", ImGuiTableColumnFlags_WidthFixed);
+            ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Hits", ImGuiTableColumnFlags_WidthFixed);
+            ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed);
+            ImGui::TableHeadersRow();
+
+            for (std::size_t i = 0; i < counts.size(); ++i) {
+                const auto& c = counts[i];
+                ImGui::TableNextRow();
+                ImGui::PushID(static_cast<int>(i));
+
+                ImGui::TableSetColumnIndex(0);
+                const bool is_selected = selected_instance && *selected_instance == i;
+                if (ImGui::Selectable(
+                            std::format("{}", c.pid).c_str(), is_selected,
+                            ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap
+                    )) {
+                    selected_instance = i;
+                }
+
+                ImGui::TableSetColumnIndex(1);
+                ImGui::TextUnformatted(c.name.c_str());
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%zu", c.hits);
+
+                ImGui::TableSetColumnIndex(3);
+                ImGui::BeginDisabled(engine.is_scanning());
+                if (ImGui::SmallButton("x")) {
+                    detach = c.pid;
+                }
+                ImGui::EndDisabled();
+                ImGui::PopID();
+            }
+            ImGui::EndTable();
+        }
+
+        if (detach) {
+            engine.remove(*detach);
+            selected_instance.reset();
+        }
+        if (engine.instance_count() == 0) {
+            ImGui::TextDisabled("No processes attached.");
+        }
+    }
+
+    void multi_scanner_view::draw_results() {
+        if (!selected_instance || *selected_instance >= engine.instance_count()) {
+            ImGui::TextDisabled("Select an instance to list its results.");
+            return;
+        }
+        if (engine.is_scanning()) {
+            ImGui::TextDisabled("Scanning...");
+            return;
+        }
+
+        auto& instance = engine.engine(*selected_instance);
+        auto& process = engine.process_of(*selected_instance);
+
+        auto lock = instance.lock_results();
+        const auto& results = instance.get_results();
+        if (instance.has_snapshot()) {
+            ImGui::TextDisabled("Candidates are kept as a memory snapshot until a next scan lists them.");
+            return;
+        }
+        if (results.empty()) {
+            ImGui::TextDisabled("No results.");
+            return;
+        }
+
+        const ImGuiTableFlags flags =
+                ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("MultiResTable", 2, flags)) {
+            ImGui::TableSetupColumn("Address");
+            ImGui::TableSetupColumn("Value");
+            ImGui::TableHeadersRow();
+
+            const std::size_t value_size = core::scanner::value_size(config);
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(results.size()));
+            std::vector<std::uintptr_t> visible;
+            std::vector<core::scan_data_type> types;
+            std::vector<std::byte> values;
+            std::vector<core::read_request> requests;
+            std::vector<std::uint8_t> readable;
+            while (clipper.Step()) {
+                const auto first = static_cast<std::size_t>(clipper.DisplayStart);
+                const auto rows = static_cast<std::size_t>(clipper.DisplayEnd - clipper.DisplayStart);
+                visible.resize(rows);
+                results.read(first, visible);
+
+                // numeric results read as the type they were found as, everything else as the scan was set up. the
+                // rows on screen are read in one batch
+                types.assign(rows, config.data_type);
+                std::size_t bytes = 0;
+                for (std::size_t r = 0; r < rows; ++r) {
+                    if (config.data_type == core::scan_data_type::numeric) {
+                        types[r] = instance.result_type(first + r).value_or(config.data_type);
+                    }
+                    bytes += types[r] == config.data_type ? value_size : core::scanner::type_size(types[r]);
+                }
+                values.resize(bytes);
+                requests.clear();
+                for (std::size_t r = 0, offset = 0; r < rows; ++r) {
+                    const std::size_t size =
+                            types[r] == config.data_type ? value_size : core::scanner::type_size(types[r]);
+                    requests.push_back({visible[r], std::span(values).subspan(offset, size)});
+                    offset += size;
+                }
+                readable.resize(rows);
+                process.read_memory_batch(requests, readable);
+
+                for (std::size_t r = 0; r < rows; ++r) {
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::Text("0x%llX", static_cast<unsigned long long>(visible[r]));
+
+                    ImGui::TableSetColumnIndex(1);
+                    if (readable[r]) {
+                        const std::vector<std::byte> buf(requests[r].buffer.begin(), requests[r].buffer.end());
+                        ImGui::Text("%s", core::scanner::format_value(buf, types[r]).c_str());
+                    } else {
+                        ImGui::TextDisabled("??");
+                    }
+                }
+            }
+            clipper.End();
+            ImGui::EndTable();
+        }
+    }
+} // namespace ui
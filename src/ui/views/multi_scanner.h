@@ -0,0 +1,44 @@
+#pragma once
+
+#include <core/process.h>
+#include <core/scanner/multi_scanner.h>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <ui/view.h>
+#include <vector>
+
+#include <imgui.h>
+
+namespace ui {
+    // the scanner over several processes at once, usually every running instance of one binary
+    class multi_scanner_view final : public view {
+    public:
+        multi_scanner_view();
+        void render() override;
+
+    private:
+        void draw_processes();
+        void draw_config();
+        void draw_instances();
+        void draw_results();
+
+        core::multi_scanner engine;
+        core::scan_config config;
+        // only lists processes, the instances attach processes of their own
+        core::process lister;
+
+        std::vector<core::process_info> processes;
+        std::set<std::uint32_t> checked;
+        ImGuiTextFilter filter;
+        std::string attach_message;
+
+        char val_buf[512]{};
+        int selected_type_idx = 5; // i32
+        int selected_cmp_idx = 0;  // exact
+        bool intersect = false;
+        bool is_first_scan = true;
+        std::optional<std::size_t> selected_instance;
+    };
+} // namespace ui
@@ -34,7 +34,7 @@ namespace ui {
         }
         if (ImGui::Button("Attach") && can_attach) {
             const auto& selected_process = m_processes[*m_selected_index];
-            auto result = live_target->attach_to(selected_process.pid);
+            auto result = attach(*live_target, selected_process.pid);
             if (!result) {
                 // todo: log or show error popup
             }
@@ -83,7 +83,7 @@ namespace ui {
                     m_selected_index = i;
                 }
                 if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(0)) {
-                    if (target.attach_to(process.pid)) {
+                    if (attach(target, process.pid)) {
                         m_selected_index = i;
                     }
                 }
@@ -95,4 +95,12 @@ namespace ui {
             ImGui::EndTable();
         }
     }
+
+    std::expected<void, core::error_code> processes_view::attach(core::process& target, std::uint32_t pid) {
+        // frozen addresses and cached pages belong to the process attached until now
+        app::freezer->set_target(&target);
+        auto result = target.attach_to(pid);
+        app::page_cache->set_target(&target);
+        return result;
+    }
 } // namespace ui
@@ -23,5 +23,7 @@ namespace ui {
         ImGuiTextFilter m_filter;
 
         void process_table(core::process& target, const ImGuiTextFilter& filter);
+        // switches target to pid, along with everything that holds on to the process attached until now
+        static std::expected<void, core::error_code> attach(core::process& target, std::uint32_t pid);
     };
 } // namespace ui
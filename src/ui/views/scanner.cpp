@@ -4,12 +4,55 @@
 #include <ui/theme.h>
 #include <ui/views/scanner.h>
 
+#include <algorithm>
+#include <charconv>
 #include <cstring>
 #include <format>
+#include <string_view>
 
 namespace ui {
-    const char* type_names[] = {"u8", "i8", "u16", "i16", "u32", "i32", "u64", "i64", "f32", "f64"};
-    const char* cmp_names[] = {"Exact", "Greater", "Less"};
+    const char* type_names[13] = {"u8",  "i8",  "u16", "i16", "u32",   "i32",        "u64",
+                                  "i64", "f32", "f64", "AOB", "Group", "All Numeric"};
+    const char* cmp_names[16] = {"Exact",     "Not Equal", "Greater",      "Less",         "Between",
+                                 "Rounded",   "Truncated", "Approx +/-",   "Changed",      "Unchanged",
+                                 "Increased", "Decreased", "Increased By", "Decreased By", "Within +/-",
+                                 "Unknown"};
+
+    // group fields take the value types and the modes that don't need a previous scan, the leading entries of each
+    constexpr int field_type_count = 10;
+    constexpr int field_cmp_count = 8;
+
+    namespace {
+        // "0,2-3" style cpu lists, anything that doesn't parse is skipped
+        std::vector<std::uint32_t> parse_cpus(std::string_view text) {
+            std::vector<std::uint32_t> cpus;
+            while (!text.empty()) {
+                const auto comma = text.find(',');
+                const auto item = text.substr(0, comma);
+                text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+
+                std::uint32_t first = 0;
+                std::uint32_t last = 0;
+                const auto dash = item.find('-');
+                const auto head = item.substr(0, dash);
+                if (std::from_chars(head.data(), head.data() + head.size(), first).ec != std::errc{})
+                    continue;
+                last = first;
+                if (dash != std::string_view::npos) {
+                    const auto tail = item.substr(dash + 1);
+                    if (std::from_chars(tail.data(), tail.data() + tail.size(), last).ec != std::errc{} || last < first)
+                        continue;
+                }
+                for (auto cpu = first; cpu <= last && cpus.size() < 1024; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+            std::ranges::sort(cpus);
+            const auto [dupes, end] = std::ranges::unique(cpus);
+            cpus.erase(dupes, end);
+            return cpus;
+        }
+    } // namespace
 
     scanner_view::scanner_view() : view("Scanner"), engine(nullptr) {
     }
@@ -19,6 +62,8 @@ namespace ui {
             last_target = app::active_target.get();
             engine.set_target(last_target);
             engine.reset();
+            app::freezer->set_target(last_target);
+            load_budget();
             is_first_scan = true;
             selected_result_idx.reset();
             write_message.clear();
@@ -59,11 +104,58 @@ namespace ui {
         ImGui::Text("Scan Configuration");
         ImGui::Separator();
 
-        ImGui::InputText("Value", val_buf, sizeof(val_buf));
+        // relative modes need a previous scan to compare against, unknown only makes sense as the first one.
+        // byte patterns only ever match exactly and groups carry a mode per field
+        const auto data_type = static_cast<core::scan_data_type>(selected_type_idx);
+        const bool is_pattern = data_type == core::scan_data_type::bytes;
+        const bool is_group = data_type == core::scan_data_type::group;
+        const bool is_numeric = data_type == core::scan_data_type::numeric;
+        auto mode_allowed = [&](int idx) {
+            const auto type = static_cast<core::scan_compare_type>(idx);
+            if (is_pattern || is_group)
+                return type == core::scan_compare_type::exact;
+            // a numeric scan has to find something to know the types by
+            if (is_numeric && type == core::scan_compare_type::unknown)
+                return false;
+            return is_first_scan ? !core::scanner::is_relative(type) : type != core::scan_compare_type::unknown;
+        };
+        if (!mode_allowed(selected_cmp_idx)) {
+            selected_cmp_idx = 0;
+        }
+
+        const auto cmp_type = static_cast<core::scan_compare_type>(selected_cmp_idx);
+        ImGui::BeginDisabled(is_group || !core::scanner::needs_value(cmp_type));
+        const char* hint = "";
+        if (is_pattern) {
+            hint = "48 8B 05 ?? ?? ?? ??";
+        } else if (cmp_type == core::scan_compare_type::between) {
+            hint = "min..max";
+        } else if (cmp_type == core::scan_compare_type::approx) {
+            hint = "value~epsilon";
+        }
+        ImGui::InputTextWithHint("Value", hint, val_buf, sizeof(val_buf));
+        ImGui::EndDisabled();
         ImGui::Combo("Type", &selected_type_idx, type_names, IM_ARRAYSIZE(type_names));
-        ImGui::Combo("Mode", &selected_cmp_idx, cmp_names, IM_ARRAYSIZE(cmp_names));
+
+        if (ImGui::BeginCombo("Mode", cmp_names[selected_cmp_idx])) {
+            for (int i = 0; i < IM_ARRAYSIZE(cmp_names); i++) {
+                if (!mode_allowed(i))
+                    continue;
+                if (ImGui::Selectable(cmp_names[i], i == selected_cmp_idx)) {
+                    selected_cmp_idx = i;
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        if (is_group) {
+            draw_fields();
+        }
 
         ImGui::Checkbox("Fast Scan (Aligned)", &config.fast_scan);
+        ImGui::Checkbox("Resident Pages Only", &config.resident_only);
+        ImGui::InputInt("Memory (MB)", &memory_budget_mb, 64, 256);
+        memory_budget_mb = std::max(memory_budget_mb, 16);
 
         ImGui::Spacing();
         ImGui::Separator();
@@ -72,6 +164,16 @@ namespace ui {
         config.data_type = static_cast<core::scan_data_type>(selected_type_idx);
         config.compare_type = static_cast<core::scan_compare_type>(selected_cmp_idx);
         config.value_str = val_buf;
+        config.fields.clear();
+        if (is_group) {
+            for (const auto& row : field_rows) {
+                config.fields.push_back(
+                        {row.offset, static_cast<core::scan_data_type>(row.type_idx),
+                         static_cast<core::scan_compare_type>(row.cmp_idx), row.value}
+                );
+            }
+        }
+        config.memory_budget = static_cast<std::size_t>(memory_budget_mb) * 1024 * 1024;
 
         if (engine.is_scanning()) {
             if (ImGui::Button("Cancel Scan", ImVec2(-1, 30))) {
@@ -85,9 +187,11 @@ namespace ui {
                     is_first_scan = false;
                 }
             } else {
+                ImGui::BeginDisabled(is_pattern);
                 if (ImGui::Button("Next Scan", ImVec2(-1, 30))) {
                     engine.begin_next_scan(config);
                 }
+                ImGui::EndDisabled();
                 ImGui::Spacing();
                 if (ImGui::Button("Reset / New Scan", ImVec2(-1, 0))) {
                     engine.reset();
@@ -96,10 +200,200 @@ namespace ui {
                     write_message.clear();
                 }
             }
+            draw_session();
+            if (last_target->is_live()) {
+                draw_budget();
+                draw_frozen();
+            }
+        }
+
+        ImGui::Spacing();
+        // a running scan is counted from its stream, the result count would wait on the results lock
+        ImGui::TextDisabled(
+                "Found: %zu", engine.is_scanning() ? engine.get_stream().found() : engine.result_count()
+        );
+
+        if (!engine.is_scanning()) {
+            auto lock = engine.lock_results();
+            if (const auto spilled = engine.get_results().spilled_bytes(); spilled > 0) {
+                ImGui::TextDisabled("Spilled to disk: %zu MB", spilled / (1024 * 1024));
+            }
+            if (const auto skipped = engine.skipped_bytes(); skipped > 0) {
+                ImGui::TextDisabled("Not resident, skipped: %zu MB", skipped / (1024 * 1024));
+            }
+        }
+    }
+
+    void scanner_view::draw_session() {
+        ImGui::Spacing();
+        ImGui::Separator();
+        ImGui::InputTextWithHint("##SessionPath", "Session file...", session_path, sizeof(session_path));
+
+        ImGui::BeginDisabled(is_first_scan);
+        if (ImGui::Button("Save Session")) {
+            const auto saved = engine.save_session(session_path, config);
+            session_message = saved ? "Session saved." : "Save failed.";
+        }
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+
+        // the results come back where their regions are now, the config as they were found, so a next scan can
+        // pick up from there
+        if (ImGui::Button("Load Session")) {
+            if (auto loaded = engine.load_session(session_path)) {
+                config = std::move(*loaded);
+                selected_type_idx = static_cast<int>(config.data_type);
+                selected_cmp_idx = static_cast<int>(config.compare_type);
+                std::strncpy(val_buf, config.value_str.c_str(), sizeof(val_buf) - 1);
+                val_buf[sizeof(val_buf) - 1] = '\0';
+
+                field_rows.clear();
+                for (const auto& field : config.fields) {
+                    auto& row = field_rows.emplace_back();
+                    row.offset = static_cast<std::uint32_t>(field.offset);
+                    row.type_idx = static_cast<int>(field.type);
+                    row.cmp_idx = static_cast<int>(field.compare);
+                    std::strncpy(row.value, field.value_str.c_str(), sizeof(row.value) - 1);
+                }
+                memory_budget_mb = static_cast<int>(config.memory_budget / (1024 * 1024));
+
+                is_first_scan = false;
+                selected_result_idx.reset();
+                write_message.clear();
+                session_message = std::format("Loaded {} results.", engine.result_count());
+            } else {
+                session_message = "Load failed.";
+            }
+        }
+
+        if (!session_message.empty()) {
+            ImGui::TextDisabled("%s", session_message.c_str());
+        }
+    }
+
+    void scanner_view::load_budget() {
+        budget_mbps = 0;
+        budget_reads = 0;
+        budget_cpus[0] = '\0';
+        if (!last_target)
+            return;
+
+        const auto limits = last_target->budget().limits();
+        budget_mbps = static_cast<int>(limits.bytes_per_second / (1024 * 1024));
+        budget_reads = static_cast<int>(limits.calls_per_second);
+        std::string cpus;
+        for (const auto cpu : limits.cpus) {
+            cpus += std::format("{}{}", cpus.empty() ? "" : ",", cpu);
+        }
+        std::strncpy(budget_cpus, cpus.c_str(), sizeof(budget_cpus) - 1);
+        budget_cpus[sizeof(budget_cpus) - 1] = '\0';
+    }
+
+    void scanner_view::draw_budget() {
+        ImGui::Spacing();
+        ImGui::Separator();
+        ImGui::Text("I/O Budget");
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Shared by the scanner, strings and xref scans of this target, 0 for no limit");
+        }
+
+        ImGui::InputInt("MB/s", &budget_mbps, 1, 10);
+        ImGui::InputInt("Reads/s", &budget_reads, 100, 1000);
+        budget_mbps = std::max(budget_mbps, 0);
+        budget_reads = std::max(budget_reads, 0);
+        ImGui::InputTextWithHint("CPUs", "any, or 0,2-3", budget_cpus, sizeof(budget_cpus));
+
+        if (ImGui::Button("Apply Budget")) {
+            core::io_limits limits;
+            limits.bytes_per_second = static_cast<std::uint64_t>(budget_mbps) * 1024 * 1024;
+            limits.calls_per_second = static_cast<std::uint64_t>(budget_reads);
+            limits.cpus = parse_cpus(budget_cpus);
+            last_target->budget().set_limits(std::move(limits));
+        }
+
+        if (const auto waited = last_target->budget().throttled_ns(); waited > 0) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("Throttled %.1f s", static_cast<double>(waited) / 1e9);
+        }
+    }
+
+    void scanner_view::draw_frozen() {
+        ImGui::Spacing();
+        ImGui::Separator();
+        ImGui::Text("Frozen");
+
+        ImGui::SetNextItemWidth(-1);
+        if (ImGui::SliderFloat(
+                    "##FreezeRate", &freeze_rate, 1.0f, static_cast<float>(core::freezer::max_rate), "%.0f Hz",
+                    ImGuiSliderFlags_Logarithmic
+            )) {
+            app::freezer->set_rate(freeze_rate);
+        }
+
+        const auto entries = app::freezer->entries();
+        if (entries.empty()) {
+            ImGui::TextDisabled("Nothing frozen.");
+            return;
+        }
+
+        for (const auto& entry : entries) {
+            ImGui::PushID(static_cast<int>(entry.address));
+            if (ImGui::SmallButton("x")) {
+                app::freezer->unfreeze(entry.address);
+            }
+            ImGui::SameLine();
+            ImGui::Text(
+                    "0x%llX  %s", static_cast<unsigned long long>(entry.address),
+                    core::scanner::format_value(entry.value, static_cast<core::scan_data_type>(entry.tag)).c_str()
+            );
+            ImGui::PopID();
+        }
+        if (ImGui::Button("Unfreeze All", ImVec2(-1, 0))) {
+            app::freezer->clear();
+        }
+
+        const auto stats = app::freezer->stats();
+        ImGui::TextDisabled(
+                "Tick: %.1f us mean, %.1f us max", static_cast<double>(stats.mean_ns) / 1000.0,
+                static_cast<double>(stats.max_ns) / 1000.0
+        );
+        ImGui::TextDisabled(
+                "Rewrites: %llu  Late: %llu  Failed: %llu", static_cast<unsigned long long>(stats.rewrites),
+                static_cast<unsigned long long>(stats.late_ticks), static_cast<unsigned long long>(stats.failures)
+        );
+    }
+
+    void scanner_view::draw_fields() {
+        ImGui::Spacing();
+        ImGui::Text("Fields");
+
+        const std::uint32_t step = 1;
+        const std::uint32_t step_fast = 8;
+        for (std::size_t i = 0; i < field_rows.size(); i++) {
+            auto& row = field_rows[i];
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::Separator();
+
+            ImGui::InputScalar(
+                    "Offset", ImGuiDataType_U32, &row.offset, &step, &step_fast, "%X",
+                    ImGuiInputTextFlags_CharsHexadecimal
+            );
+            ImGui::Combo("Type", &row.type_idx, type_names, field_type_count);
+            ImGui::Combo("Mode", &row.cmp_idx, cmp_names, field_cmp_count);
+            ImGui::InputText("Value", row.value, sizeof(row.value));
+
+            const bool removed = ImGui::Button("Remove");
+            ImGui::PopID();
+            if (removed) {
+                field_rows.erase(field_rows.begin() + static_cast<std::ptrdiff_t>(i));
+                break;
+            }
         }
 
+        if (ImGui::Button("Add Field", ImVec2(-1, 0))) {
+            field_rows.emplace_back();
+        }
         ImGui::Spacing();
-        ImGui::TextDisabled("Found: %zu", engine.result_count());
     }
 
     void scanner_view::draw_status() {
@@ -108,62 +402,158 @@ namespace ui {
     }
 
     void scanner_view::draw_results() {
+        // hits of a running scan come from its stream, without the results lock the worker takes to publish the
+        // final list. rows are only selectable once that list is in
+        if (engine.is_scanning()) {
+            const auto& stream = engine.get_stream();
+            if (stream.empty()) {
+                ImGui::TextDisabled("No results yet.");
+                return;
+            }
+            draw_table(stream.size(), [&](std::size_t index, std::span<std::uintptr_t> out) {
+                return stream.read(index, out);
+            }, false);
+            return;
+        }
+
         auto lock = engine.lock_results();
 
         const auto& results = engine.get_results();
+        if (engine.has_snapshot()) {
+            ImGui::TextDisabled(
+                    "Candidates are kept as a memory snapshot until fewer than %zu remain.",
+                    config.materialize_threshold
+            );
+            return;
+        }
+
         if (results.empty()) {
             ImGui::TextDisabled("No results.");
             return;
         }
 
+        draw_table(results.size(), [&](std::size_t index, std::span<std::uintptr_t> out) {
+            return results.read(index, out);
+        }, true);
+    }
+
+    template <typename Reader>
+    void scanner_view::draw_table(std::size_t count, Reader read, bool selectable) {
         const ImGuiTableFlags flags =
                 ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
 
-        if (ImGui::BeginTable("ResTable", 2, flags)) {
+        // numeric results each have a type of their own. streamed hits don't carry it, only the results do, which
+        // the selectable table is drawn from with the results lock held
+        const bool is_numeric = config.data_type == core::scan_data_type::numeric;
+        auto row_type = [&](std::size_t index) -> std::optional<core::scan_data_type> {
+            if (!is_numeric)
+                return config.data_type;
+            return selectable ? engine.result_type(index) : std::nullopt;
+        };
+
+        if (ImGui::BeginTable("ResTable", is_numeric ? 3 : 2, flags)) {
             ImGui::TableSetupColumn("Address");
             ImGui::TableSetupColumn("Value");
+            if (is_numeric) {
+                ImGui::TableSetupColumn("Type");
+            }
             ImGui::TableHeadersRow();
 
+            const std::size_t value_size = core::scanner::value_size(config);
+            auto row_size = [&](const std::optional<core::scan_data_type>& type) {
+                return is_numeric && type ? core::scanner::type_size(*type) : value_size;
+            };
+
             ImGuiListClipper clipper;
-            clipper.Begin(static_cast<int>(results.size()));
+            clipper.Begin(static_cast<int>(count));
+            std::vector<std::uintptr_t> visible;
+            std::vector<std::optional<core::scan_data_type>> types;
+            std::vector<std::byte> values;
+            std::vector<core::read_request> requests;
+            std::vector<std::uint8_t> readable;
             while (clipper.Step()) {
+                // decode the rows on screen in one go rather than locating every row on its own
+                const auto first = static_cast<std::size_t>(clipper.DisplayStart);
+                const auto rows = static_cast<std::size_t>(clipper.DisplayEnd - clipper.DisplayStart);
+                visible.resize(rows);
+                read(first, visible);
+
+                // and read their values in one batch as well
+                types.resize(rows);
+                std::size_t bytes = 0;
+                for (std::size_t r = 0; r < rows; ++r) {
+                    types[r] = row_type(first + r);
+                    bytes += row_size(types[r]);
+                }
+                values.resize(bytes);
+                requests.clear();
+                for (std::size_t r = 0, offset = 0; r < rows; ++r) {
+                    requests.push_back({visible[r], std::span(values).subspan(offset, row_size(types[r]))});
+                    offset += row_size(types[r]);
+                }
+                readable.resize(rows);
+                app::page_cache->read_memory_batch(requests, readable);
+
                 for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
-                    const auto& res = results[static_cast<std::size_t>(i)];
+                    const auto r = static_cast<std::size_t>(i) - first;
+                    const std::uintptr_t address = visible[r];
+                    const auto& type = types[r];
+                    const std::vector<std::byte> buf(requests[r].buffer.begin(), requests[r].buffer.end());
                     ImGui::TableNextRow();
                     ImGui::PushID(i);
 
                     ImGui::TableSetColumnIndex(0);
-                    char label[32];
-                    std::snprintf(label, sizeof(label), "##selectable%d", i);
-
-                    const bool is_selected = selected_result_idx && *selected_result_idx == static_cast<std::size_t>(i);
-                    if (ImGui::Selectable(
-                                label, is_selected,
-                                ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap
-                        )) {
-                        selected_result_idx = static_cast<std::size_t>(i);
-                        write_message.clear();
-                        std::vector<std::byte> buf(core::scanner::type_size(config.data_type));
-                        if (auto read_res = app::active_target->read_memory(res.address, buf); read_res) {
-                            std::string val_str = core::scanner::format_value(buf, config.data_type);
-                            std::strncpy(write_buf, val_str.c_str(), sizeof(write_buf) - 1);
-                            write_buf[sizeof(write_buf) - 1] = '\0';
-                        } else {
-                            write_buf[0] = '\0';
+                    if (selectable) {
+                        char label[32];
+                        std::snprintf(label, sizeof(label), "##selectable%d", i);
+
+                        const bool is_selected =
+                                selected_result_idx && *selected_result_idx == static_cast<std::size_t>(i);
+                        if (ImGui::Selectable(
+                                    label, is_selected,
+                                    ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap
+                            )) {
+                            selected_result_idx = static_cast<std::size_t>(i);
+                            write_message.clear();
+                            if (readable[r] && type) {
+                                std::string val_str = core::scanner::format_value(buf, *type);
+                                std::strncpy(write_buf, val_str.c_str(), sizeof(write_buf) - 1);
+                                write_buf[sizeof(write_buf) - 1] = '\0';
+                            } else {
+                                write_buf[0] = '\0';
+                            }
                         }
+                        ImGui::SameLine();
                     }
-
-                    ImGui::SameLine();
-                    ImGui::Text("0x%llX", static_cast<unsigned long long>(res.address));
+                    ImGui::Text("0x%llX", static_cast<unsigned long long>(address));
 
                     ImGui::TableSetColumnIndex(1);
-                    std::vector<std::byte> buf(core::scanner::type_size(config.data_type));
-                    if (auto read_res = app::active_target->read_memory(res.address, buf); read_res) {
-                        std::string val_str = core::scanner::format_value(buf, config.data_type);
+                    if (!type) {
+                        ImGui::TextDisabled("-");
+                    } else if (readable[r]) {
+                        std::string val_str;
+                        if (config.data_type == core::scan_data_type::group) {
+                            // one value per field rather than the raw bytes of the whole group
+                            for (const auto& field : config.fields) {
+                                const auto at = buf.begin() + static_cast<std::ptrdiff_t>(field.offset);
+                                const std::vector<std::byte> field_buf(
+                                        at, at + static_cast<std::ptrdiff_t>(core::scanner::type_size(field.type))
+                                );
+                                val_str += (val_str.empty() ? "" : " | ") +
+                                           core::scanner::format_value(field_buf, field.type);
+                            }
+                        } else {
+                            val_str = core::scanner::format_value(buf, *type);
+                        }
                         ImGui::Text("%s", val_str.c_str());
                     } else {
                         ImGui::TextDisabled("??");
                     }
+
+                    if (is_numeric) {
+                        ImGui::TableSetColumnIndex(2);
+                        ImGui::TextDisabled("%s", type ? type_names[static_cast<int>(*type)] : "-");
+                    }
                     ImGui::PopID();
                 }
             }
@@ -173,16 +563,24 @@ namespace ui {
     }
 
     void scanner_view::draw_editor() {
+        if (engine.is_scanning())
+            return;
+
         auto lock = engine.lock_results();
         const auto& results = engine.get_results();
         if (!selected_result_idx || *selected_result_idx >= results.size()) {
             return;
         }
 
-        const auto& res = results[*selected_result_idx];
+        const std::uintptr_t address = results.address(*selected_result_idx);
+        // numeric results are written as the type they were found as
+        auto type = config.data_type;
+        if (type == core::scan_data_type::numeric) {
+            type = engine.result_type(*selected_result_idx).value_or(type);
+        }
 
         ImGui::Separator();
-        ImGui::Text("Edit value at 0x%llX", static_cast<unsigned long long>(res.address));
+        ImGui::Text("Edit value at 0x%llX", static_cast<unsigned long long>(address));
         ImGui::SameLine();
 
         ImGui::SetNextItemWidth(150.f);
@@ -191,15 +589,29 @@ namespace ui {
 
         if (ImGui::Button("Write")) {
             write_message.clear();
-            auto new_bytes = core::scanner::parse_input(write_buf, config.data_type);
+            auto new_bytes = core::scanner::parse_input(write_buf, type);
             if (new_bytes) {
-                if (auto write_res = last_target->write_memory(res.address, *new_bytes); !write_res) {
+                if (auto write_res = app::page_cache->write_memory(address, *new_bytes); !write_res) {
                     write_message = "Write failed.";
                 }
             } else {
                 write_message = "Invalid value format.";
             }
         }
+        ImGui::SameLine();
+
+        if (app::freezer->is_frozen(address)) {
+            if (ImGui::Button("Unfreeze")) {
+                app::freezer->unfreeze(address);
+            }
+        } else if (ImGui::Button("Freeze")) {
+            write_message.clear();
+            if (auto new_bytes = core::scanner::parse_input(write_buf, type)) {
+                app::freezer->freeze(address, *new_bytes, static_cast<std::uint8_t>(type));
+            } else {
+                write_message = "Invalid value format.";
+            }
+        }
 
         if (!write_message.empty()) {
             ImGui::SameLine();
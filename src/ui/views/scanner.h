@@ -1,11 +1,18 @@
 #pragma once
 
+#include <core/freezer.h>
 #include <core/scanner/scanner.h>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <ui/view.h>
+#include <vector>
 
 namespace ui {
+    // display names in scan_data_type and scan_compare_type order
+    extern const char* type_names[13];
+    extern const char* cmp_names[16];
+
     class scanner_view final : public view {
     public:
         scanner_view();
@@ -13,7 +20,15 @@ namespace ui {
 
     private:
         void draw_config();
+        void draw_fields();
+        void draw_session();
+        void draw_budget();
+        void load_budget();
+        void draw_frozen();
         void draw_results();
+        // one row per address, read(index, out) fills out with the addresses from index on
+        template <typename Reader>
+        void draw_table(std::size_t count, Reader read, bool selectable);
         void draw_status();
         void draw_editor();
 
@@ -21,12 +36,27 @@ namespace ui {
         core::scan_config config;
         core::target* last_target = nullptr;
 
-        char val_buf[128]{};
-        char write_buf[128]{};
+        struct field_row {
+            std::uint32_t offset = 0;
+            int type_idx = 5; // i32
+            int cmp_idx = 0;  // exact
+            char value[64]{};
+        };
+
+        char val_buf[512]{}; // fits long byte patterns
+        char write_buf[512]{};
+        float freeze_rate = static_cast<float>(core::freezer::default_rate);
+        int budget_mbps = 0;
+        int budget_reads = 0;
+        char budget_cpus[128]{};
         std::string write_message;
+        char session_path[1024]{};
+        std::string session_message;
         std::optional<std::size_t> selected_result_idx;
         int selected_type_idx = 5; // i32
         int selected_cmp_idx = 0;  // exact
+        std::vector<field_row> field_rows;
+        int memory_budget_mb = static_cast<int>(core::result_store::default_memory_budget / (1024 * 1024));
         bool is_first_scan = true;
     };
 } // namespace ui
@@ -26,6 +26,9 @@ namespace ui {
         ImGui::SameLine();
         ImGui::Checkbox("Exec", &config.scan_executable);
 
+        ImGui::SameLine();
+        ImGui::Checkbox("Resident", &config.resident_only);
+
         ImGui::SameLine();
         ImGui::SetNextItemWidth(80);
         int min_len = static_cast<int>(config.min_length);
@@ -47,6 +50,10 @@ namespace ui {
         ImGui::Separator();
 
         ImGui::Text("Total Found: %zu", total_count);
+        if (const auto skipped = analyzer.skipped_bytes(); skipped > 0) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(%zu MB not resident, skipped)", skipped / (1024 * 1024));
+        }
 
         const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY |
                                       ImGuiTableFlags_SizingFixedFit;
@@ -69,6 +76,7 @@ namespace ui {
                 }
 
                 std::size_t fetched = analyzer.get_batch(start, std::span(batch_buffer.data(), count));
+                analyzer.read_strings(app::page_cache.get(), std::span(batch_buffer.data(), fetched), texts);
 
                 for (std::size_t i = 0; i < fetched; ++i) {
                     const auto& ref = batch_buffer[i];
@@ -82,7 +90,7 @@ namespace ui {
                     ImGui::Text("%u", ref.length);
 
                     ImGui::TableSetColumnIndex(2);
-                    std::string text = analyzer.read_string(app::active_target.get(), ref);
+                    std::string& text = texts[i];
                     if (text.size() > 100)
                         text = text.substr(0, 97) + "...";
                     ImGui::TextUnformatted(text.c_str());
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <core/analysis/strings.h>
+#include <string>
 #include <ui/view.h>
 #include <vector>
 
@@ -15,6 +16,7 @@ namespace ui {
         core::analysis::string_scan_config config;
 
         std::vector<core::analysis::string_ref> batch_buffer;
+        std::vector<std::string> texts;
         std::size_t total_count = 0;
     };
 
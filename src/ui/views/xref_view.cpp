@@ -13,6 +13,7 @@
 #include <core/target.h>
 #include <imgui.h>
 #include <ui/theme.h>
+#include <util/affinity.h>
 
 import zydis;
 
@@ -111,6 +112,13 @@ namespace ui {
             ImGui::Text("%zu Items", filtered_indices.size());
         }
 
+        ImGui::SameLine();
+        ImGui::Checkbox("Resident only", &resident_only);
+        if (skipped_bytes > 0) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("%zu KB skipped", skipped_bytes / 1024);
+        }
+
         ImGui::SameLine();
         ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
         if (ImGui::InputTextWithHint("##filter", "Filter...", filter_buffer, sizeof(filter_buffer))) {
@@ -276,37 +284,41 @@ namespace ui {
             expanded_items.clear();
             is_scanning = true;
             progress = 0.0f;
+            skipped_bytes = 0;
         }
 
-        scan_thread = std::jthread([this](std::stop_token st) {
-            scan_task(current_target, st);
+        scan_thread = std::jthread([this, only_resident = resident_only](std::stop_token st) {
+            scan_task(current_target, only_resident, st);
         });
     }
 
-    void xref_view::scan_task(core::target* t, std::stop_token st) {
+    void xref_view::scan_task(core::target* t, bool only_resident, std::stop_token st) {
         if (!t)
             return;
 
-        auto regions_opt = t->get_memory_regions();
-        if (!regions_opt)
+        auto table = t->get_region_table();
+        if (!table)
             return;
 
-        const auto& regions = *regions_opt;
+        core::pin_current_thread(t->budget().cpus());
+
         std::vector<core::memory_region> code_segments;
         std::vector<core::memory_region> data_segments;
         size_t total_code_size = 0;
 
-        for (const auto& r : regions) {
-            if (r.permission.find('x') != std::string::npos) {
-                code_segments.push_back(r);
-                total_code_size += r.size;
-            } else if (r.permission.find('r') != std::string::npos) {
-                data_segments.push_back(r);
+        for (const auto& e : (*table)->entries()) {
+            if (e.has(core::perm::exec)) {
+                code_segments.push_back((*table)->region(e));
+                total_code_size += e.size;
+                t->advise(e.base_address, e.size, core::access_pattern::sequential);
+            } else if (e.has(core::perm::read)) {
+                data_segments.push_back((*table)->region(e));
             }
         }
 
         std::map<uintptr_t, xref_item> result_map;
         std::vector<std::byte> buffer;
+        std::vector<core::memory_run> runs;
         size_t processed = 0;
 
         for (const auto& region : code_segments) {
@@ -321,72 +333,93 @@ namespace ui {
                     break;
 
                 size_t chunk = std::min(buffer.size(), region.size - offset);
-                if (!t->read_memory(region.base_address + offset, std::span(buffer.data(), chunk))) {
-                    offset += chunk;
-                    continue;
+                const std::uintptr_t chunk_base = region.base_address + offset;
+
+                // pages that aren't in memory are left alone rather than faulted in, when asked. zero filled runs
+                // decode to nothing worth a reference and are skipped regardless
+                if (only_resident) {
+                    skipped_bytes += core::resident_runs(*t, chunk_base, chunk, runs);
+                } else {
+                    t->data_runs(chunk_base, chunk, runs);
                 }
 
-                const uint8_t* ptr = reinterpret_cast<const uint8_t*>(buffer.data());
-                size_t chunk_offset = 0;
-
-                while (chunk_offset < chunk) {
-                    if ((chunk_offset % 2048) == 0) {
-                        progress = static_cast<float>(processed + offset + chunk_offset) /
-                                   static_cast<float>(total_code_size);
-                    }
-
-                    auto info = zydis::disassemble_format(ptr + chunk_offset);
-                    if (!info) {
-                        chunk_offset++;
+                for (const auto& run : runs) {
+                    const size_t run_offset = run.address - chunk_base;
+
+                    // targets holding their bytes lend the run in place, with an instruction's worth past it so the
+                    // decoder never runs off the end of what was lent
+                    const std::byte* run_data = nullptr;
+                    if (auto lent = t->view_memory(run.address, run.size + ZYDIS_MAX_INSTRUCTION_LENGTH)) {
+                        run_data = lent->data();
+                    } else if (t->budget().acquire(run.size, 1, st) &&
+                               t->read_memory(run.address, std::span(buffer.data() + run_offset, run.size))) {
+                        run_data = buffer.data() + run_offset;
+                    } else {
                         continue;
                     }
 
-                    const auto& [instr, text] = *info;
-                    uintptr_t ip = region.base_address + offset + chunk_offset;
+                    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(run_data);
+                    size_t chunk_offset = run_offset;
+
+                    while (chunk_offset < run_offset + run.size) {
+                        if ((chunk_offset % 2048) == 0) {
+                            progress = static_cast<float>(processed + offset + chunk_offset) /
+                                       static_cast<float>(total_code_size);
+                        }
 
-                    for (int i = 0; i < instr.decoded.operand_count_visible; ++i) {
-                        const auto& op = instr.operands[i];
-                        uintptr_t target = 0;
-                        bool found = false;
+                        auto info = zydis::disassemble_format(ptr + (chunk_offset - run_offset));
+                        if (!info) {
+                            chunk_offset++;
+                            continue;
+                        }
 
-                        if (op.type == ZYDIS_OPERAND_TYPE_MEMORY) {
-                            if (op.mem.base == ZYDIS_REGISTER_RIP) {
-                                ZyanU64 abs = 0;
-                                if (ZYAN_SUCCESS(ZydisCalcAbsoluteAddress(&instr.decoded, &op, ip, &abs))) {
-                                    target = static_cast<uintptr_t>(abs);
-                                    found = true;
-                                }
-                            } else if (op.mem.base == ZYDIS_REGISTER_NONE && op.mem.index == ZYDIS_REGISTER_NONE) {
-                                if (op.mem.disp.value != 0) {
-                                    target = static_cast<uintptr_t>(op.mem.disp.value);
-                                    found = true;
+                        const auto& [instr, text] = *info;
+                        uintptr_t ip = region.base_address + offset + chunk_offset;
+
+                        for (int i = 0; i < instr.decoded.operand_count_visible; ++i) {
+                            const auto& op = instr.operands[i];
+                            uintptr_t target = 0;
+                            bool found = false;
+
+                            if (op.type == ZYDIS_OPERAND_TYPE_MEMORY) {
+                                if (op.mem.base == ZYDIS_REGISTER_RIP) {
+                                    ZyanU64 abs = 0;
+                                    if (ZYAN_SUCCESS(ZydisCalcAbsoluteAddress(&instr.decoded, &op, ip, &abs))) {
+                                        target = static_cast<uintptr_t>(abs);
+                                        found = true;
+                                    }
+                                } else if (op.mem.base == ZYDIS_REGISTER_NONE && op.mem.index == ZYDIS_REGISTER_NONE) {
+                                    if (op.mem.disp.value != 0) {
+                                        target = static_cast<uintptr_t>(op.mem.disp.value);
+                                        found = true;
+                                    }
                                 }
                             }
-                        }
 
-                        if (found) {
-                            for (const auto& ds : data_segments) {
-                                if (target >= ds.base_address && target < ds.base_address + ds.size) {
-                                    auto& item = result_map[target];
-                                    if (item.address == 0) {
-                                        item.address = target;
-                                        item.name = make_name(target, op.size);
-                                        item.value = make_val_def(op.size);
+                            if (found) {
+                                for (const auto& ds : data_segments) {
+                                    if (target >= ds.base_address && target < ds.base_address + ds.size) {
+                                        auto& item = result_map[target];
+                                        if (item.address == 0) {
+                                            item.address = target;
+                                            item.name = make_name(target, op.size);
+                                            item.value = make_val_def(op.size);
+                                        }
+
+                                        std::string type = "r";
+                                        if (instr.decoded.mnemonic == ZYDIS_MNEMONIC_MOV && i == 0)
+                                            type = "w";
+                                        else if (instr.decoded.mnemonic == ZYDIS_MNEMONIC_LEA)
+                                            type = "o";
+
+                                        item.refs.push_back({ip, text, type});
+                                        break;
                                     }
-
-                                    std::string type = "r";
-                                    if (instr.decoded.mnemonic == ZYDIS_MNEMONIC_MOV && i == 0)
-                                        type = "w";
-                                    else if (instr.decoded.mnemonic == ZYDIS_MNEMONIC_LEA)
-                                        type = "o";
-
-                                    item.refs.push_back({ip, text, type});
-                                    break;
                                 }
                             }
                         }
+                        chunk_offset += instr.decoded.length;
                     }
-                    chunk_offset += instr.decoded.length;
                 }
                 offset += chunk;
             }
@@ -49,7 +49,7 @@ namespace ui {
         void apply_filter();
         void rebuild_layout();
 
-        void scan_task(core::target* t, std::stop_token st);
+        void scan_task(core::target* t, bool only_resident, std::stop_token st);
 
         core::target* current_target = nullptr;
 
@@ -63,8 +63,10 @@ namespace ui {
         std::jthread scan_thread;
         std::atomic<bool> is_scanning = false;
         std::atomic<float> progress = 0.0f;
+        std::atomic<std::size_t> skipped_bytes = 0;
 
         char filter_buffer[256] = {};
+        bool resident_only = false;
         bool filter_dirty = false;
         bool layout_dirty = false;
     };
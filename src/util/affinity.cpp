@@ -0,0 +1,80 @@
+#include <util/affinity.h>
+
+#include <algorithm>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace core {
+    namespace {
+        // what the thread could run on before it was first pinned, and the set it has now
+        struct thread_affinity {
+            bool captured = false;
+#if defined(_WIN32)
+            DWORD_PTR original = 0;
+#else
+            cpu_set_t original{};
+#endif
+            std::vector<std::uint32_t> current;
+        };
+
+        thread_local thread_affinity affinity;
+    } // namespace
+
+    void pin_current_thread(std::span<const std::uint32_t> cpus) {
+        if (std::ranges::equal(cpus, affinity.current))
+            return;
+
+#if defined(_WIN32)
+        DWORD_PTR mask = 0;
+        for (const auto cpu : cpus) {
+            if (cpu < sizeof(DWORD_PTR) * 8) {
+                mask |= DWORD_PTR{1} << cpu;
+            }
+        }
+        if (!affinity.captured) {
+            DWORD_PTR process_mask = 0;
+            DWORD_PTR system_mask = 0;
+            if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+                return;
+            affinity.original = process_mask;
+            affinity.captured = true;
+        }
+        if (cpus.empty()) {
+            mask = affinity.original;
+        }
+        if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+            return;
+#else
+        if (!affinity.captured) {
+            if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &affinity.original) != 0)
+                return;
+            affinity.captured = true;
+        }
+
+        cpu_set_t set = affinity.original;
+        if (!cpus.empty()) {
+            CPU_ZERO(&set);
+            for (const auto cpu : cpus) {
+                if (cpu < CPU_SETSIZE) {
+                    CPU_SET(cpu, &set);
+                }
+            }
+        }
+        if (CPU_COUNT(&set) == 0 || pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) != 0)
+            return;
+#endif
+        affinity.current.assign(cpus.begin(), cpus.end());
+    }
+
+    std::span<const std::uint32_t> pinned_cpus() {
+        return affinity.current;
+    }
+} // namespace core
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace core {
+    // restricts the calling thread to cpus, or lifts the restriction again when cpus is empty. cpus the system
+    // doesn't have are ignored, a set that leaves none of them changes nothing. repeating the set the thread
+    // already has costs no syscall
+    void pin_current_thread(std::span<const std::uint32_t> cpus);
+
+    // the set the calling thread was last pinned to, empty when it isn't
+    std::span<const std::uint32_t> pinned_cpus();
+} // namespace core
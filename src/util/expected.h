@@ -11,6 +11,8 @@ namespace core {
         read_failed,
         write_failed,
         partial_read,
+        invalid_format,
+        not_supported,
 
         ptrace_attach_failed,
         ptrace_detach_failed,
@@ -0,0 +1,266 @@
+#include <util/mapped_file.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core {
+    mapped_region::mapped_region(void* base, std::size_t size, void* mapping) :
+        m_base(base), m_size(size), m_mapping(mapping) {
+    }
+
+    mapped_region::~mapped_region() {
+        reset();
+    }
+
+    mapped_region::mapped_region(mapped_region&& other) noexcept :
+        m_base(std::exchange(other.m_base, nullptr)), m_size(std::exchange(other.m_size, 0)),
+        m_mapping(std::exchange(other.m_mapping, nullptr)) {
+    }
+
+    mapped_region& mapped_region::operator=(mapped_region&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_base = std::exchange(other.m_base, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+        }
+        return *this;
+    }
+
+    void mapped_region::reset() {
+        if (!m_base)
+            return;
+
+#if defined(_WIN32)
+        UnmapViewOfFile(m_base);
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+#else
+        munmap(m_base, m_size);
+#endif
+        m_base = nullptr;
+        m_size = 0;
+        m_mapping = nullptr;
+    }
+
+    std::expected<mapped_region, error_code> mapped_region::open(const std::filesystem::path& path) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileW(
+                path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL, nullptr
+        );
+        if (file == INVALID_HANDLE_VALUE) {
+            return std::unexpected(error_code::read_failed);
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            return std::unexpected(error_code::read_failed);
+        }
+        if (size.QuadPart == 0) {
+            CloseHandle(file);
+            return mapped_region();
+        }
+
+        // the section keeps the file open, the handle isn't needed past this
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) {
+            return std::unexpected(error_code::read_failed);
+        }
+
+        void* base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!base) {
+            CloseHandle(mapping);
+            return std::unexpected(error_code::read_failed);
+        }
+        return mapped_region(base, static_cast<std::size_t>(size.QuadPart), mapping);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            return std::unexpected(error_code::read_failed);
+        }
+
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            close(fd);
+            return std::unexpected(error_code::read_failed);
+        }
+        if (st.st_size == 0) {
+            close(fd);
+            return mapped_region();
+        }
+
+        // the mapping holds its own reference to the file
+        const auto size = static_cast<std::size_t>(st.st_size);
+        void* base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            return std::unexpected(error_code::read_failed);
+        }
+        return mapped_region(base, size, nullptr);
+#endif
+    }
+
+    void mapped_region::advise(std::size_t offset, std::size_t size, access_pattern pattern) const {
+        if (!m_base || offset >= m_size)
+            return;
+        size = std::min(size, m_size - offset);
+
+#if defined(_WIN32)
+        // the cache manager reads ahead on its own, there is no per range hint to give it
+        (void) size;
+        (void) pattern;
+#else
+        // madvise wants a page aligned start, the region itself is one
+        static const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        const std::size_t start = offset / page * page;
+
+        int advice = MADV_NORMAL;
+        switch (pattern) {
+            case access_pattern::normal:
+                advice = MADV_NORMAL;
+                break;
+            case access_pattern::sequential:
+                advice = MADV_SEQUENTIAL;
+                break;
+            case access_pattern::random:
+                advice = MADV_RANDOM;
+                break;
+        }
+        madvise(static_cast<std::byte*>(m_base) + start, offset + size - start, advice);
+#endif
+    }
+
+    scratch_file::scratch_file(std::intptr_t handle) : m_handle(handle) {
+    }
+
+    scratch_file::~scratch_file() {
+        reset();
+    }
+
+    scratch_file::scratch_file(scratch_file&& other) noexcept :
+        m_handle(std::exchange(other.m_handle, -1)), m_size(std::exchange(other.m_size, 0)) {
+    }
+
+    scratch_file& scratch_file::operator=(scratch_file&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_handle = std::exchange(other.m_handle, -1);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    void scratch_file::reset() {
+        if (m_handle == -1)
+            return;
+
+#if defined(_WIN32)
+        CloseHandle(reinterpret_cast<HANDLE>(m_handle));
+#else
+        close(static_cast<int>(m_handle));
+#endif
+        m_handle = -1;
+        m_size = 0;
+    }
+
+    std::expected<scratch_file, error_code> scratch_file::create() {
+        std::error_code ec;
+        auto dir = std::filesystem::temp_directory_path(ec);
+        if (ec) {
+            return std::unexpected(error_code::write_failed);
+        }
+
+#if defined(_WIN32)
+        wchar_t name[MAX_PATH];
+        if (!GetTempFileNameW(dir.c_str(), L"rvl", 0, name)) {
+            return std::unexpected(error_code::write_failed);
+        }
+
+        HANDLE file = CreateFileW(
+                name, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr
+        );
+        if (file == INVALID_HANDLE_VALUE) {
+            return std::unexpected(error_code::write_failed);
+        }
+        return scratch_file(reinterpret_cast<std::intptr_t>(file));
+#else
+        std::string path = (dir / "ravel-XXXXXX").string();
+        int fd = mkstemp(path.data());
+        if (fd == -1) {
+            return std::unexpected(error_code::write_failed);
+        }
+
+        // nothing but the descriptor refers to it from here on
+        unlink(path.c_str());
+        return scratch_file(fd);
+#endif
+    }
+
+    std::expected<mapped_region, error_code> scratch_file::extend(std::size_t size) {
+        if (m_handle == -1) {
+            return std::unexpected(error_code::write_failed);
+        }
+
+        size = (size + granularity - 1) / granularity * granularity;
+        const std::size_t offset = m_size;
+        const std::size_t new_size = offset + size;
+
+#if defined(_WIN32)
+        auto file = reinterpret_cast<HANDLE>(m_handle);
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(new_size);
+        if (!SetFilePointerEx(file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+            return std::unexpected(error_code::out_of_memory);
+        }
+
+        HANDLE mapping = CreateFileMappingW(
+                file, nullptr, PAGE_READWRITE, static_cast<DWORD>(new_size >> 32), static_cast<DWORD>(new_size), nullptr
+        );
+        if (!mapping) {
+            return std::unexpected(error_code::out_of_memory);
+        }
+
+        void* base = MapViewOfFile(
+                mapping, FILE_MAP_WRITE, static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset), size
+        );
+        if (!base) {
+            CloseHandle(mapping);
+            return std::unexpected(error_code::out_of_memory);
+        }
+
+        m_size = new_size;
+        return mapped_region(base, size, mapping);
+#else
+        const int fd = static_cast<int>(m_handle);
+        if (ftruncate(fd, static_cast<off_t>(new_size)) != 0) {
+            return std::unexpected(error_code::out_of_memory);
+        }
+
+        void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, static_cast<off_t>(offset));
+        if (base == MAP_FAILED) {
+            return std::unexpected(error_code::out_of_memory);
+        }
+
+        m_size = new_size;
+        return mapped_region(base, size, nullptr);
+#endif
+    }
+} // namespace core
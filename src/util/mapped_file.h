@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+
+#include <util/expected.h>
+
+namespace core {
+    // how a range is about to be read, passed on to the os so it can read ahead or hold back
+    enum class access_pattern {
+        normal,
+        sequential,
+        random,
+    };
+
+    // owning view of a mapped file range, unmapped on destruction
+    class mapped_region {
+    public:
+        mapped_region() = default;
+        // maps all of an existing file read only, nothing is read until it is touched. bytes() must not be written
+        // through, and an empty file gives an empty region
+        static std::expected<mapped_region, error_code> open(const std::filesystem::path& path);
+        ~mapped_region();
+
+        mapped_region(mapped_region&& other) noexcept;
+        mapped_region& operator=(mapped_region&& other) noexcept;
+        mapped_region(const mapped_region&) = delete;
+        mapped_region& operator=(const mapped_region&) = delete;
+
+        [[nodiscard]] std::span<std::byte> bytes() const {
+            return {static_cast<std::byte*>(m_base), m_size};
+        }
+
+        // hint for [offset, offset + size) of the region, ignored where the os has nothing to match it
+        void advise(std::size_t offset, std::size_t size, access_pattern pattern) const;
+
+    private:
+        friend class scratch_file;
+        mapped_region(void* base, std::size_t size, void* mapping);
+
+        void reset();
+
+        void* m_base = nullptr;
+        std::size_t m_size = 0;
+        void* m_mapping = nullptr; // section handle on windows
+    };
+
+    // temporary file that only exists through its handle and mappings, the os drops it once closed
+    class scratch_file {
+    public:
+        // extend() rounds up to this so every mapping offset satisfies the os alignment rules
+        static constexpr std::size_t granularity = 64 * 1024;
+
+        static std::expected<scratch_file, error_code> create();
+        ~scratch_file();
+
+        scratch_file(scratch_file&& other) noexcept;
+        scratch_file& operator=(scratch_file&& other) noexcept;
+        scratch_file(const scratch_file&) = delete;
+        scratch_file& operator=(const scratch_file&) = delete;
+
+        // grows the file by at least size bytes and maps the new tail read-write
+        [[nodiscard]] std::expected<mapped_region, error_code> extend(std::size_t size);
+
+        [[nodiscard]] std::size_t size() const {
+            return m_size;
+        }
+
+    private:
+        explicit scratch_file(std::intptr_t handle);
+
+        void reset();
+
+        std::intptr_t m_handle = -1;
+        std::size_t m_size = 0;
+    };
+} // namespace core
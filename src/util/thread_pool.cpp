@@ -0,0 +1,126 @@
+#include <util/thread_pool.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <util/affinity.h>
+
+namespace core {
+    thread_pool::thread_pool(std::size_t threads) {
+        threads = std::max<std::size_t>(threads, 1);
+
+        queues.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            queues.push_back(std::make_unique<queue>());
+        }
+
+        workers.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this, i](std::stop_token st) {
+                worker_loop(i, st);
+            });
+        }
+    }
+
+    thread_pool::~thread_pool() {
+        for (auto& w : workers) {
+            w.request_stop();
+        }
+        workers.clear();
+    }
+
+    thread_pool& thread_pool::shared() {
+        static thread_pool pool;
+        return pool;
+    }
+
+    std::size_t thread_pool::size() const {
+        return queues.size();
+    }
+
+    void thread_pool::parallel_for(
+            std::size_t count, const std::function<void(std::size_t task, std::size_t worker)>& fn
+    ) {
+        if (count == 0)
+            return;
+
+        struct completion {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::size_t remaining = 0;
+        } done;
+        done.remaining = count;
+
+        const std::vector<std::uint32_t> cpus(pinned_cpus().begin(), pinned_cpus().end());
+
+        // counted before they are published, a worker may steal and finish one before this loop is done
+        {
+            std::lock_guard lock(sleep_mutex);
+            pending += count;
+        }
+
+        // contiguous slices per worker so neighbouring tasks stay on one core until somebody steals them
+        for (std::size_t i = 0; i < count; ++i) {
+            auto& q = *queues[i * queues.size() / count];
+            std::lock_guard lock(q.mutex);
+            // every task sets the affinity it wants, so a pinned scan leaves nothing behind for the next one
+            q.tasks.emplace_back([&fn, &done, &cpus, i](std::size_t worker) {
+                pin_current_thread(cpus);
+                fn(i, worker);
+
+                std::lock_guard done_lock(done.mutex);
+                if (--done.remaining == 0) {
+                    done.cv.notify_all();
+                }
+            });
+        }
+
+        wake.notify_all();
+
+        std::unique_lock lock(done.mutex);
+        done.cv.wait(lock, [&] {
+            return done.remaining == 0;
+        });
+    }
+
+    bool thread_pool::run_one(std::size_t worker) {
+        std::function<void(std::size_t)> task;
+
+        {
+            auto& own = *queues[worker];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+            }
+        }
+
+        for (std::size_t i = 1; !task && i < queues.size(); ++i) {
+            auto& victim = *queues[(worker + i) % queues.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+
+        if (!task)
+            return false;
+
+        --pending;
+        task(worker);
+        return true;
+    }
+
+    void thread_pool::worker_loop(std::size_t worker, std::stop_token st) {
+        while (!st.stop_requested()) {
+            if (run_one(worker))
+                continue;
+
+            std::unique_lock lock(sleep_mutex);
+            wake.wait(lock, st, [this] {
+                return pending > 0;
+            });
+        }
+    }
+} // namespace core
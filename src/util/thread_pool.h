@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core {
+    // fixed size pool where every worker owns a deque, pops its own work from the back and steals from the
+    // front of the others once it runs dry
+    class thread_pool {
+    public:
+        explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency());
+        ~thread_pool();
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+        thread_pool(thread_pool&&) = delete;
+        thread_pool& operator=(thread_pool&&) = delete;
+
+        // process wide pool sized to the core count
+        static thread_pool& shared();
+
+        [[nodiscard]] std::size_t size() const;
+
+        // runs fn(task, worker) for every task in [0, count) and blocks until all of them returned. worker is
+        // in [0, size()) and stable for the lifetime of the pool, so callers can keep per-worker scratch.
+        // must not be called from inside a pool task. the tasks run on the cpus the calling thread is pinned to,
+        // see pin_current_thread
+        void parallel_for(std::size_t count, const std::function<void(std::size_t task, std::size_t worker)>& fn);
+
+    private:
+        struct queue {
+            std::mutex mutex;
+            std::deque<std::function<void(std::size_t)>> tasks;
+        };
+
+        bool run_one(std::size_t worker);
+        void worker_loop(std::size_t worker, std::stop_token st);
+
+        std::vector<std::unique_ptr<queue>> queues;
+        std::vector<std::jthread> workers;
+
+        std::mutex sleep_mutex;
+        std::condition_variable_any wake;
+        std::atomic<std::size_t> pending = 0;
+    };
+} // namespace core
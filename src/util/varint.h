@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace core {
+    // little endian base 128, seven bits per byte with the top bit set on every byte but the last
+    inline void put_varint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    inline std::optional<std::uint64_t> get_varint(std::span<const std::uint8_t> in, std::size_t& pos) {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (pos >= in.size())
+                return std::nullopt;
+
+            const std::uint8_t byte = in[pos++];
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+        return std::nullopt;
+    }
+} // namespace core
@@ -0,0 +1,211 @@
+// runs every scan and byte pair kernel of each level the host supports against level::scalar on random buffers:
+// every type, predicate and source, aligned and unaligned scans, buffers starting off any alignment and lengths
+// around the 64 byte blocks the vector loops walk
+
+#include <core/scanner/simd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+    using core::simd::level;
+    using core::simd::predicate;
+    using core::simd::source;
+
+    constexpr std::array levels = {level::sse2, level::avx2, level::avx512};
+    constexpr std::array predicates = {
+            predicate::eq, predicate::ne, predicate::gt, predicate::lt, predicate::between
+    };
+    constexpr std::array sources = {source::constant, source::previous};
+
+    // every length up to a few blocks, then some around larger block counts
+    std::vector<std::size_t> lengths() {
+        std::vector<std::size_t> out;
+        for (std::size_t n = 0; n <= 200; ++n) {
+            out.push_back(n);
+        }
+        for (const std::size_t n : {255uz, 256uz, 257uz, 1000uz, 4096uz, 4096uz + 63}) {
+            out.push_back(n);
+        }
+        return out;
+    }
+
+    const char* level_name(level l) {
+        switch (l) {
+            case level::scalar:
+                return "scalar";
+            case level::sse2:
+                return "sse2";
+            case level::avx2:
+                return "avx2";
+            case level::avx512:
+                return "avx512";
+        }
+        return "?";
+    }
+
+    // mostly a few small values so every predicate both hits and misses, the rest random bytes, which for floats
+    // takes in nans, infinities and denormals
+    template <typename T>
+    T pick(std::mt19937_64& rng) {
+        T value;
+        if (rng() % 4 != 0) {
+            value = static_cast<T>(rng() % 4);
+        } else {
+            const std::uint64_t bits = rng();
+            std::memcpy(&value, &bits, sizeof(T));
+        }
+        return value;
+    }
+
+    template <typename T>
+    void fill(std::span<std::byte> out, std::mt19937_64& rng) {
+        for (std::size_t i = 0; i + sizeof(T) <= out.size(); i += sizeof(T)) {
+            const T value = pick<T>(rng);
+            std::memcpy(out.data() + i, &value, sizeof(T));
+        }
+        for (std::size_t i = out.size() / sizeof(T) * sizeof(T); i < out.size(); ++i) {
+            out[i] = static_cast<std::byte>(rng());
+        }
+    }
+
+    bool same(std::span<const std::uint32_t> expected, std::size_t want, std::span<const std::uint32_t> got,
+              std::size_t have) {
+        return std::ranges::equal(expected.first(want), got.first(have));
+    }
+
+    struct checker {
+        std::mt19937_64 rng{0x5eed};
+        std::size_t runs = 0;
+        std::size_t failures = 0;
+
+        template <typename T>
+        void scan_kernels(const char* type_name) {
+            constexpr std::size_t max_start = 8;
+            const auto sizes = lengths();
+            const std::size_t room = sizes.back() + max_start;
+
+            std::vector<std::byte> data(room);
+            std::vector<std::byte> previous(room);
+            std::vector<std::byte> previous_upper(room);
+            std::vector<std::uint32_t> expected(room + 1);
+            std::vector<std::uint32_t> got(room + 1);
+
+            for (const auto l : levels) {
+                if (l > core::simd::supported_level())
+                    continue;
+
+                for (const auto p : predicates) {
+                    for (const auto s : sources) {
+                        const auto reference = core::simd::select<T>(p, s, level::scalar);
+                        const auto kernel = core::simd::select<T>(p, s, l);
+
+                        for (const std::size_t align : {std::size_t{1}, sizeof(T), std::size_t{3}}) {
+                            for (const std::size_t size : sizes) {
+                                // the previous values mostly equal the current ones so relative modes hit too
+                                const std::size_t start = rng() % max_start;
+                                const std::size_t used = start + size;
+                                fill<T>(std::span(data).first(used), rng);
+                                std::copy_n(data.begin(), used, previous.begin());
+                                fill<T>(std::span(previous).first(used / 3), rng);
+                                fill<T>(std::span(previous_upper).first(used), rng);
+
+                                const auto view = std::span<const std::byte>(data).subspan(start, size);
+
+                                core::simd::operands<T> args;
+                                args.value = pick<T>(rng);
+                                args.upper = pick<T>(rng);
+                                if (args.upper < args.value) {
+                                    std::swap(args.value, args.upper);
+                                }
+                                args.previous = previous.data() + start;
+                                args.previous_upper = previous_upper.data() + start;
+
+                                const std::size_t want = reference(view, align, args, expected.data());
+                                const std::size_t have = kernel(view, align, args, got.data());
+                                ++runs;
+
+                                if (!same(expected, want, got, have) && failures++ < 20) {
+                                        std::println(
+                                                stderr, "{} {}: predicate {} source {} align {} start {} size {}: "
+                                                        "{} hits, scalar has {}",
+                                                level_name(l), type_name, static_cast<int>(p), static_cast<int>(s),
+                                                align, start, size, have, want
+                                        );
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void pair_kernels() {
+            const auto sizes = lengths();
+            std::vector<std::byte> data(sizes.back() + 8);
+            std::vector<std::uint32_t> expected(data.size() + 1);
+            std::vector<std::uint32_t> got(data.size() + 1);
+            const auto reference = core::simd::select_pair(level::scalar);
+
+            for (const auto l : levels) {
+                if (l > core::simd::supported_level())
+                    continue;
+
+                const auto kernel = core::simd::select_pair(l);
+                for (const std::size_t size : sizes) {
+                    // few distinct bytes, so pairs turn up often
+                    for (auto& b : data) {
+                        b = static_cast<std::byte>(rng() % 3);
+                    }
+
+                    const std::size_t start = rng() % 8;
+                    const auto view = std::span<const std::byte>(data).subspan(start, size);
+
+                    core::simd::byte_pair pair;
+                    pair.first = static_cast<std::uint8_t>(rng() % 3);
+                    pair.last = static_cast<std::uint8_t>(rng() % 3);
+                    pair.first_at = rng() % 4;
+                    pair.last_at = pair.first_at + rng() % 70;
+
+                    const std::size_t want = reference(view, pair, expected.data());
+                    const std::size_t have = kernel(view, pair, got.data());
+                    ++runs;
+
+                    if (!same(expected, want, got, have) && failures++ < 20) {
+                        std::println(
+                                stderr, "{} pair: at {} and {} start {} size {}: {} hits, scalar has {}",
+                                level_name(l), pair.first_at, pair.last_at, start, size, have, want
+                        );
+                    }
+                }
+            }
+        }
+    };
+} // namespace
+
+int main() {
+    std::println("host level: {}", level_name(core::simd::supported_level()));
+
+    checker c;
+    c.scan_kernels<std::uint8_t>("u8");
+    c.scan_kernels<std::int8_t>("i8");
+    c.scan_kernels<std::uint16_t>("u16");
+    c.scan_kernels<std::int16_t>("i16");
+    c.scan_kernels<std::uint32_t>("u32");
+    c.scan_kernels<std::int32_t>("i32");
+    c.scan_kernels<std::uint64_t>("u64");
+    c.scan_kernels<std::int64_t>("i64");
+    c.scan_kernels<float>("f32");
+    c.scan_kernels<double>("f64");
+    c.pair_kernels();
+
+    std::println("{} runs, {} failed", c.runs, c.failures);
+    return c.failures == 0 ? 0 : 1;
+}